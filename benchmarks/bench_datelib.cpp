@@ -0,0 +1,585 @@
+#include "datelib/BusinessDayIndex.h"
+#include "datelib/BusinessDayRange.h"
+#include "datelib/CalendarLoader.h"
+#include "datelib/DayCount.h"
+#include "datelib/HolidayCalendar.h"
+#include "datelib/Schedule.h"
+#include "datelib/date.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace {
+
+#ifndef DATELIB_VERSION
+#define DATELIB_VERSION "unknown"
+#endif
+
+// Number of dates queried per timed call
+constexpr std::size_t QUERY_COUNT = 4096;
+
+// First year of every calendar horizon
+constexpr int FIRST_YEAR = 2000;
+
+/**
+ * @brief Command line options for the benchmark run
+ */
+struct Options {
+    std::string json_path;
+    std::string filter;
+    double min_sample_seconds = 0.01;
+    int samples = 5;
+    bool quick = false;
+};
+
+/**
+ * @brief Parameters identifying one point of a sweep
+ */
+using Params = std::vector<std::pair<std::string, long long>>;
+
+/**
+ * @brief Timing summary of one benchmark
+ */
+struct Result {
+    std::string name;
+    Params params;
+    std::size_t iterations = 0;
+    double ns_per_op = 0.0;
+    double min_ns_per_op = 0.0;
+};
+
+// Results are folded into this value so the optimizer cannot discard the measured work
+volatile std::size_t g_sink = 0;
+
+/**
+ * @brief Minimal timing harness: calibrate, sample, report the median
+ */
+class Harness {
+  public:
+    explicit Harness(Options options) : options_(std::move(options)) {}
+
+    /**
+     * @brief Time a callable
+     * @param name Benchmark name
+     * @param params Sweep parameters, reported alongside the timing
+     * @param ops Number of operations performed by one call, used to report time per operation
+     * @param func Callable returning a checksum of its work
+     */
+    template <typename Func>
+    void run(const std::string& name, Params params, std::size_t ops, Func&& func) {
+        auto label = describe(name, params);
+        if (!options_.filter.empty() && label.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        // Warm up: fills per-year caches so that steady-state query cost is measured
+        g_sink = g_sink + func();
+
+        // Calibrate the number of calls per sample
+        std::size_t iterations = 1;
+        while (time(iterations, func) < options_.min_sample_seconds && iterations < (1U << 30)) {
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        for (int s = 0; s < options_.samples; ++s) {
+            auto seconds = time(iterations, func);
+            samples.push_back(seconds * 1e9 / static_cast<double>(iterations * ops));
+        }
+        std::ranges::sort(samples);
+
+        Result result{name, std::move(params), iterations, samples[samples.size() / 2],
+                      samples.front()};
+        // Progress goes to stderr so that stdout carries only the JSON document
+        std::fprintf(stderr, "%-60s %12.2f ns/op\n", label.c_str(), result.ns_per_op);
+        results_.push_back(std::move(result));
+    }
+
+    /**
+     * @brief Write every result as a JSON document
+     */
+    void writeJson(std::ostream& out) const {
+        out << "{\n  \"context\": {\n";
+        out << "    \"library_version\": \"" << DATELIB_VERSION << "\",\n";
+        out << "    \"date\": \"" << timestamp() << "\",\n";
+        out << "    \"compiler\": \"" << escape(compiler()) << "\",\n";
+        out << "    \"samples\": " << options_.samples << "\n  },\n";
+        out << "  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const auto& result = results_[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << escape(result.name)
+                << "\", \"params\": {";
+            for (std::size_t p = 0; p < result.params.size(); ++p) {
+                out << (p == 0 ? "" : ", ") << '"' << escape(result.params[p].first)
+                    << "\": " << result.params[p].second;
+            }
+            out << "}, \"iterations\": " << result.iterations
+                << ", \"ns_per_op\": " << result.ns_per_op
+                << ", \"min_ns_per_op\": " << result.min_ns_per_op << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    [[nodiscard]] bool quick() const noexcept { return options_.quick; }
+
+  private:
+    template <typename Func>
+    static double time(std::size_t iterations, Func& func) {
+        std::size_t checksum = 0;
+        auto start = steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            checksum += func();
+        }
+        auto elapsed = steady_clock::now() - start;
+        g_sink = g_sink + checksum;
+        return duration<double>(elapsed).count();
+    }
+
+    static std::string describe(const std::string& name, const Params& params) {
+        std::string label = name;
+        for (const auto& [key, value] : params) {
+            label += "/" + key + ":" + std::to_string(value);
+        }
+        return label;
+    }
+
+    static std::string escape(std::string_view text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    static std::string compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    static std::string timestamp() {
+        auto now = system_clock::to_time_t(system_clock::now());
+        std::tm utc{};
+#if defined(_WIN32)
+        gmtime_s(&utc, &now);
+#else
+        gmtime_r(&now, &utc);
+#endif
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+        return buffer;
+    }
+
+    Options options_;
+    std::vector<Result> results_;
+};
+
+/**
+ * @brief Build a calendar with a few recurring rules and a number of explicit holidays
+ */
+datelib::HolidayCalendar makeCalendar(int explicit_holidays, int years) {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    calendar.addRule(std::make_unique<datelib::NthWeekdayRule>("Memorial Day", 5, 1,
+                                                               datelib::Occurrence::Last));
+    calendar.addRule(std::make_unique<datelib::NthWeekdayRule>("Thanksgiving", 11, 4,
+                                                               datelib::Occurrence::Fourth));
+
+    std::minstd_rand rng(42);
+    for (int i = 0; i < explicit_holidays; ++i) {
+        auto year = FIRST_YEAR + static_cast<int>(rng() % static_cast<unsigned>(years));
+        auto index = static_cast<unsigned>(rng() % 365);
+        calendar.addHoliday("Holiday " + std::to_string(i % 64),
+                            datelib::YearBitmap::dateAt(year, index));
+    }
+    return calendar;
+}
+
+/**
+ * @brief Spread query dates pseudo-randomly over a horizon
+ */
+std::vector<year_month_day> makeQueries(int years, bool sorted) {
+    std::minstd_rand rng(7);
+    sys_days first{year{FIRST_YEAR} / January / 1};
+    auto span = (sys_days{year{FIRST_YEAR + years} / January / 1} - first).count();
+
+    std::vector<year_month_day> queries;
+    queries.reserve(QUERY_COUNT);
+    for (std::size_t i = 0; i < QUERY_COUNT; ++i) {
+        queries.emplace_back(first + days{static_cast<int>(rng() % static_cast<unsigned>(span))});
+    }
+    if (sorted) {
+        std::ranges::sort(queries);
+    }
+    return queries;
+}
+
+const char* conventionName(datelib::BusinessDayConvention convention) {
+    using enum datelib::BusinessDayConvention;
+    switch (convention) {
+    case Following:
+        return "Following";
+    case ModifiedFollowing:
+        return "ModifiedFollowing";
+    case Preceding:
+        return "Preceding";
+    case ModifiedPreceding:
+        return "ModifiedPreceding";
+    case Unadjusted:
+        return "Unadjusted";
+    }
+    return "Unknown";
+}
+
+void benchmarkCalendar(Harness& harness, int holidays, int years) {
+    auto calendar = makeCalendar(holidays, years);
+    auto queries = makeQueries(years, false);
+    auto sorted_queries = makeQueries(years, true);
+    Params params{{"holidays", holidays}, {"years", years}};
+
+    harness.run("isHoliday", params, queries.size(), [&] {
+        std::size_t count = 0;
+        for (const auto& date : queries) {
+            count += calendar.isHoliday(date) ? 1 : 0;
+        }
+        return count;
+    });
+
+    auto compiled = calendar.freeze(FIRST_YEAR, FIRST_YEAR + years - 1);
+    harness.run("CompiledCalendar/isHoliday", params, queries.size(), [&] {
+        std::size_t count = 0;
+        for (const auto& date : queries) {
+            count += compiled.isHoliday(date) ? 1 : 0;
+        }
+        return count;
+    });
+
+    harness.run("getHolidays", params, static_cast<std::size_t>(years), [&] {
+        std::size_t count = 0;
+        for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+            count += calendar.getHolidays(year).size();
+        }
+        return count;
+    });
+
+    harness.run("getHolidayNames", params, queries.size(), [&] {
+        std::size_t count = 0;
+        for (const auto& date : queries) {
+            count += calendar.getHolidayNames(date).size();
+        }
+        return count;
+    });
+
+    // A holiday table of the whole horizon, with names
+    harness.run("holidayTable/getHolidayNames", params, static_cast<std::size_t>(years), [&] {
+        std::size_t count = 0;
+        for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+            for (const auto& date : calendar.getHolidays(year)) {
+                for (const auto& name : calendar.getHolidayNames(date)) {
+                    count += name.size();
+                }
+            }
+        }
+        return count;
+    });
+
+    harness.run("holidayTable/forEachHoliday", params, static_cast<std::size_t>(years), [&] {
+        std::size_t count = 0;
+        calendar.forEachHoliday(year{FIRST_YEAR} / January / 1,
+                                year{FIRST_YEAR + years} / January / 1,
+                                [&](const datelib::Holiday& holiday) {
+                                    count += holiday.name.size();
+                                });
+        return count;
+    });
+
+    harness.run("isBusinessDay", params, queries.size(), [&] {
+        std::size_t count = 0;
+        for (const auto& date : queries) {
+            count += datelib::isBusinessDay(date, calendar) ? 1 : 0;
+        }
+        return count;
+    });
+
+    std::vector<sys_days> query_days(sorted_queries.begin(), sorted_queries.end());
+    std::vector<std::uint8_t> flags(query_days.size());
+    harness.run("isBusinessDay/batch", params, query_days.size(), [&] {
+        datelib::isBusinessDay(query_days, flags, calendar);
+        return static_cast<std::size_t>(std::ranges::count(flags, 1));
+    });
+
+    using enum datelib::BusinessDayConvention;
+    for (auto convention :
+         {Following, ModifiedFollowing, Preceding, ModifiedPreceding, Unadjusted}) {
+        harness.run(std::string("adjust/") + conventionName(convention), params, queries.size(),
+                    [&] {
+                        std::size_t checksum = 0;
+                        for (const auto& date : queries) {
+                            auto adjusted = datelib::adjust(date, convention, calendar);
+                            checksum += static_cast<unsigned>(adjusted.day());
+                        }
+                        return checksum;
+                    });
+    }
+
+    std::vector<year_month_day> adjusted(sorted_queries.size());
+    harness.run("adjust/batch/ModifiedFollowing", params, sorted_queries.size(), [&] {
+        datelib::adjust(sorted_queries, adjusted, ModifiedFollowing, calendar);
+        return static_cast<std::size_t>(static_cast<unsigned>(adjusted.back().day()));
+    });
+
+    harness.run("addBusinessDays/T+2", params, queries.size(), [&] {
+        std::size_t checksum = 0;
+        for (const auto& date : queries) {
+            checksum += static_cast<unsigned>(datelib::addBusinessDays(date, 2, calendar).day());
+        }
+        return checksum;
+    });
+
+    datelib::BusinessDayIndex index(calendar, FIRST_YEAR, FIRST_YEAR + years - 1);
+    harness.run("BusinessDayIndex/businessDaysBetween", params, queries.size(), [&] {
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i + 1 < queries.size(); ++i) {
+            checksum += static_cast<std::size_t>(
+                index.businessDaysBetween(sorted_queries[i], sorted_queries[i + 1]));
+        }
+        return checksum;
+    });
+
+    harness.run("HolidayCalendar/copy", params, 1, [&] {
+        datelib::HolidayCalendar copy(calendar);
+        return static_cast<std::size_t>(copy.isHoliday(queries.front()) ? 1 : 0);
+    });
+}
+
+/**
+ * @brief Time loading a text definition file; reported per byte (1000 / ns_per_op is MB/s)
+ */
+void benchmarkLoader(Harness& harness, int holidays) {
+    std::string text = "fixed,1,1,New Year's Day\nfixed,12,25,Christmas\n"
+                       "nth,5,1,last,Memorial Day\nnth,11,4,4,Thanksgiving\n";
+    std::minstd_rand rng(42);
+    for (int i = 0; i < holidays; ++i) {
+        auto date = datelib::YearBitmap::dateAt(FIRST_YEAR + static_cast<int>(rng() % 50),
+                                                static_cast<unsigned>(rng() % 365));
+        char line[64];
+        std::snprintf(line, sizeof(line), "date,%04d-%02u-%02u,Holiday %d\n",
+                      static_cast<int>(date.year()), static_cast<unsigned>(date.month()),
+                      static_cast<unsigned>(date.day()), i % 64);
+        text += line;
+    }
+
+    harness.run("loadCalendar", {{"holidays", holidays}}, text.size(), [&] {
+        datelib::HolidayCalendar calendar;
+        return datelib::loadCalendar(text, calendar).holidays;
+    });
+}
+
+/**
+ * @brief Time generating a portfolio of quarterly to annual schedules; reported per schedule
+ */
+void benchmarkSchedules(Harness& harness, int schedules) {
+    auto calendar = makeCalendar(100, 50);
+    datelib::ScheduleGenerator generator(calendar, FIRST_YEAR, FIRST_YEAR + 49);
+
+    std::minstd_rand rng(42);
+    std::vector<datelib::ScheduleSpec> specs(static_cast<std::size_t>(schedules));
+    for (auto& spec : specs) {
+        sys_days start = sys_days{year{FIRST_YEAR} / January / 1} + days{rng() % 3650};
+        spec.start = year_month_day{start};
+        spec.end = year_month_day{start + days{365 + rng() % (365 * 30)}};
+        spec.tenor = months{3 * static_cast<int>(1 + rng() % 4)};
+    }
+
+    auto offsets = datelib::ScheduleGenerator::offsets(specs);
+    std::vector<sys_days> unadjusted(offsets.back());
+    std::vector<sys_days> adjusted(offsets.back());
+
+    std::vector<unsigned> thread_counts = {1};
+    if (std::thread::hardware_concurrency() > 1) {
+        thread_counts.push_back(std::thread::hardware_concurrency());
+    }
+    for (unsigned threads : thread_counts) {
+        harness.run("ScheduleGenerator/generate",
+                    {{"schedules", schedules}, {"threads", static_cast<long long>(threads)}},
+                    specs.size(), [&] {
+                        generator.generate(specs, offsets, unadjusted, adjusted, threads);
+                        return static_cast<std::size_t>(adjusted.back().time_since_epoch().count());
+                    });
+    }
+}
+
+/**
+ * @brief Time year fractions of a column of accrual periods; reported per period
+ */
+void benchmarkDayCounts(Harness& harness) {
+    constexpr std::size_t PERIODS = 65536;
+    constexpr int YEARS = 50;
+
+    std::minstd_rand rng(42);
+    std::vector<sys_days> starts(PERIODS);
+    std::vector<sys_days> ends(PERIODS);
+    for (std::size_t i = 0; i < PERIODS; ++i) {
+        starts[i] = sys_days{year{FIRST_YEAR} / January / 1} + days{rng() % (365 * (YEARS - 2))};
+        ends[i] = starts[i] + days{1 + rng() % 730};
+    }
+    std::vector<double> fractions(PERIODS);
+
+    using enum datelib::DayCountConvention;
+    const std::pair<const char*, datelib::DayCountConvention> conventions[] = {
+        {"ACT/360", Actual360},    {"ACT/365F", Actual365Fixed},
+        {"30/360", Thirty360},     {"30E/360", ThirtyE360},
+        {"ACT/ACT ISDA", ActualActualISDA}};
+    for (const auto& [name, convention] : conventions) {
+        harness.run(std::string("yearFractions/") + name, {{"periods", PERIODS}}, PERIODS, [&] {
+            datelib::yearFractions(starts, ends, fractions, convention);
+            return static_cast<std::size_t>(fractions.back() * 1000);
+        });
+    }
+
+    auto calendar = makeCalendar(100, YEARS);
+    datelib::BusinessDayIndex index(calendar, FIRST_YEAR, FIRST_YEAR + YEARS - 1);
+    harness.run("yearFractions/BUS/252", {{"periods", PERIODS}}, PERIODS, [&] {
+        datelib::yearFractions(starts, ends, fractions, index);
+        return static_cast<std::size_t>(fractions.back() * 1000);
+    });
+}
+
+void benchmarkBusinessDayWalk(Harness& harness, int holidays) {
+    constexpr int YEARS = 10;
+    auto calendar = makeCalendar(holidays, YEARS);
+    sys_days from = year{FIRST_YEAR} / January / 1;
+    sys_days to = year{FIRST_YEAR + YEARS} / January / 1;
+    auto total_days = static_cast<std::size_t>((to - from).count());
+    Params params{{"holidays", holidays}, {"years", YEARS}};
+
+    harness.run("walk/isBusinessDay", params, total_days, [&] {
+        std::size_t count = 0;
+        for (auto day = from; day < to; day += days{1}) {
+            count += datelib::isBusinessDay(year_month_day{day}, calendar) ? 1 : 0;
+        }
+        return count;
+    });
+
+    harness.run("walk/businessDays", params, total_days, [&] {
+        std::size_t count = 0;
+        for (auto day : datelib::businessDays(from, to, calendar)) {
+            count += static_cast<std::size_t>(day.time_since_epoch().count() & 1);
+        }
+        return count;
+    });
+}
+
+void benchmarkConcurrentReads(Harness& harness, int threads) {
+    constexpr int YEARS = 10;
+    constexpr std::size_t ROUNDS = 32;
+    auto calendar = makeCalendar(100, YEARS);
+    auto queries = makeQueries(YEARS, false);
+    Params params{{"holidays", 100}, {"years", YEARS}, {"threads", threads}};
+
+    // Every thread queries its own copy; copies share the rules and the cached years
+    auto ops = static_cast<std::size_t>(threads) * ROUNDS * queries.size();
+    harness.run("isHoliday/concurrent", params, ops, [&] {
+        std::vector<std::size_t> counts(static_cast<std::size_t>(threads));
+        {
+            std::vector<std::jthread> workers;
+            for (auto& count : counts) {
+                workers.emplace_back([&count, &queries, copy = calendar] {
+                    for (std::size_t round = 0; round < ROUNDS; ++round) {
+                        for (const auto& date : queries) {
+                            count += copy.isHoliday(date) ? 1 : 0;
+                        }
+                    }
+                });
+            }
+        }
+        return std::accumulate(counts.begin(), counts.end(), std::size_t{0});
+    });
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            options.json_path = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.samples = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--quick") {
+            options.quick = true;
+            options.min_sample_seconds = 0.001;
+            options.samples = 3;
+        } else {
+            std::cerr << "Usage: datelib_bench [--json <file>] [--filter <substring>]"
+                         " [--samples <n>] [--quick]\n";
+            std::exit(arg == "--help" ? 0 : 2);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto options = parseOptions(argc, argv);
+    Harness harness(options);
+
+    std::vector<int> holiday_counts = {10, 100, 1000, 10000, 100000};
+    std::vector<int> horizons = {1, 10, 50};
+    if (harness.quick()) {
+        holiday_counts = {10, 1000};
+        horizons = {1, 10};
+    }
+
+    for (int holidays : holiday_counts) {
+        for (int years : horizons) {
+            benchmarkCalendar(harness, holidays, years);
+        }
+    }
+    for (int holidays : holiday_counts) {
+        benchmarkLoader(harness, holidays);
+    }
+    benchmarkSchedules(harness, harness.quick() ? 10000 : 100000);
+    benchmarkDayCounts(harness);
+    for (int holidays : {10, 1000}) {
+        benchmarkBusinessDayWalk(harness, holidays);
+    }
+    for (int threads : {1, 4}) {
+        benchmarkConcurrentReads(harness, threads);
+    }
+
+    if (!options.json_path.empty()) {
+        std::ofstream out(options.json_path);
+        harness.writeJson(out);
+    } else {
+        harness.writeJson(std::cout);
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "datelib/HolidayCalendar.h"
+#include "datelib/WeekendMask.h"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace datelib {
+
+/**
+ * @brief Cumulative business day counts for a calendar over a range of years
+ *
+ * The index stores, for every day of its horizon, the number of business days since the start of
+ * the horizon. Counting the business days between two dates, or the position of a date within its
+ * month or year, is then a pair of array lookups. Business days follow isBusinessDay(): a day is
+ * a business day when it is neither a weekend day nor a holiday in the calendar.
+ *
+ * The index also lists the business days of the horizon, so moving a date by n business days is
+ * a lookup by rank. The index keeps its own copy of the calendar; queries involving dates outside
+ * the horizon are answered from the calendar's per-year bitmaps, which is correct but slower.
+ *
+ * Example usage:
+ * @code
+ *   BusinessDayIndex index(calendar, 2000, 2050);
+ *   auto accrual_days = index.businessDaysBetween(start, end);
+ *   auto nth = index.businessDayOfMonth(date); // 1 for the first business day of the month
+ * @endcode
+ */
+class BusinessDayIndex {
+  public:
+    /**
+     * @brief Build an index over a range of years
+     * @param calendar The holiday calendar to index
+     * @param first_year The first year of the horizon
+     * @param last_year The last year of the horizon (inclusive)
+     * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+     * @throws std::invalid_argument if last_year is before first_year
+     */
+    BusinessDayIndex(const HolidayCalendar& calendar, int first_year, int last_year,
+                     WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+    /**
+     * @brief Get the first year of the horizon
+     */
+    [[nodiscard]] int firstYear() const noexcept { return first_year_; }
+
+    /**
+     * @brief Get the last year of the horizon (inclusive)
+     */
+    [[nodiscard]] int lastYear() const noexcept { return last_year_; }
+
+    /**
+     * @brief Check whether a date lies within the horizon
+     * @param date The date to check
+     */
+    [[nodiscard]] bool contains(const std::chrono::year_month_day& date) const noexcept;
+
+    /**
+     * @brief Check if a given date is a business day
+     * @param date The date to check
+     * @return true if the date is not a weekend day and not a holiday, false otherwise
+     * @throws std::invalid_argument if the date is invalid
+     */
+    [[nodiscard]] bool isBusinessDay(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Count the business days in the half-open range [from, to)
+     * @param from The first date of the range (counted)
+     * @param to The end of the range (not counted)
+     * @return The number of business days; negative (the count of [to, from)) if to is before
+     * from
+     * @throws std::invalid_argument if either date is invalid
+     */
+    [[nodiscard]] int businessDaysBetween(const std::chrono::year_month_day& from,
+                                          const std::chrono::year_month_day& to) const;
+
+    /**
+     * @brief Count the business days of a column of half-open ranges
+     * @param from The first day of each range (counted)
+     * @param to The end of each range (not counted)
+     * @param counts Receives the count of each range, as the scalar overload gives it; must have
+     * the same size as from and to
+     * @throws std::invalid_argument if the spans differ in size
+     *
+     * Ranges inside the horizon are a difference of two prefix counts, with no branch on their
+     * direction, so long columns (accrual periods, say) run at the speed of the loads.
+     */
+    void businessDaysBetween(std::span<const std::chrono::sys_days> from,
+                             std::span<const std::chrono::sys_days> to,
+                             std::span<int> counts) const;
+
+    /**
+     * @brief Get the position of a date among the business days of its month
+     * @param date The date to locate
+     * @return The number of business days from the first of the month up to and including date;
+     * for a business day this is its 1-based ordinal within the month
+     * @throws std::invalid_argument if the date is invalid
+     */
+    [[nodiscard]] int businessDayOfMonth(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get the position of a date among the business days of its year
+     * @param date The date to locate
+     * @return The number of business days from January 1st up to and including date; for a
+     * business day this is its 1-based ordinal within the year
+     * @throws std::invalid_argument if the date is invalid
+     */
+    [[nodiscard]] int businessDayOfYear(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Move a date by a number of business days
+     * @param date The date to start from
+     * @param n The number of business days to move; negative values move backward
+     * @return For positive n, the nth business day after date; for negative n, the |n|th
+     * business day before date; for zero, date itself if it is a business day and the following
+     * business day otherwise
+     * @throws std::invalid_argument if the date is invalid
+     * @throws BusinessDaySearchException if a whole year without business days is crossed, or if
+     * the target lies outside the years of std::chrono::year
+     *
+     * Inside the horizon the target is read from the index by rank, so the cost does not depend
+     * on n. Targets outside the horizon are found with datelib::addBusinessDays().
+     */
+    [[nodiscard]] std::chrono::year_month_day
+    addBusinessDays(const std::chrono::year_month_day& date, int n) const;
+
+  private:
+    /**
+     * @brief Count the business days in [from, to) for from <= to
+     */
+    [[nodiscard]] int countForward(std::chrono::sys_days from, std::chrono::sys_days to) const;
+
+    /**
+     * @brief Count the business days in [from, to) from per-year bitmaps, for days outside the
+     * horizon
+     */
+    [[nodiscard]] int countUnindexed(std::chrono::sys_days from, std::chrono::sys_days to) const;
+
+    HolidayCalendar calendar_;
+    WeekendMask weekend_;
+    int first_year_;
+    int last_year_;
+    std::chrono::sys_days first_day_;
+    std::chrono::sys_days end_day_;
+
+    // prefix_[i] is the number of business days in [first_day_, first_day_ + i)
+    std::vector<std::int32_t> prefix_;
+
+    // Offsets from first_day_ of every business day in the horizon, in ascending order
+    std::vector<std::int32_t> business_days_;
+};
+
+} // namespace datelib
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "datelib/WeekendMask.h"
+#include "datelib/YearBitmap.h"
+#include "datelib/detail/civil.h"
+
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+namespace datelib {
+
+// Forward declaration
+class JointCalendar;
+
+/**
+ * @brief A calendar whose business days can be read a year at a time for a given weekend
+ *
+ * HolidayCalendar, CompiledCalendar, MappedCalendar and StaticCalendar model it.
+ */
+template <typename T>
+concept BusinessDayCalendar = requires(const T& calendar, int year, WeekendMask weekend) {
+    { calendar.getBusinessDayBitmap(year, weekend) } -> std::convertible_to<YearBitmap>;
+};
+
+/**
+ * @brief Lazy view of the business days in a half-open range of days, in ascending order
+ *
+ * The view holds a pointer to the calendar and the bounds; its iterators hold the business day
+ * bitmap of the year being visited. Incrementing clears the current bit and finds the next set one
+ * with a bit scan (countr_zero), so a weekend or a run of holidays is skipped in one step, and a
+ * word without business days is skipped as a whole. The calendar is consulted once per year
+ * crossed. Neither the view nor its iterators allocate.
+ *
+ * Iterators do not refer to the view, only to the calendar, which must outlive them.
+ *
+ * Example usage:
+ * @code
+ *   for (auto day : businessDays(start, end, calendar)) {
+ *       accrue(day);
+ *   }
+ *
+ *   auto month_end = std::ranges::max(businessDays(first, last, calendar));
+ * @endcode
+ *
+ * @tparam Calendar A BusinessDayCalendar, or JointCalendar (which carries its own weekends)
+ */
+template <typename Calendar>
+class BusinessDayRange : public std::ranges::view_interface<BusinessDayRange<Calendar>> {
+  public:
+    /**
+     * @brief Iterator over the business days of the range
+     */
+    class Iterator {
+      public:
+        using value_type = std::chrono::sys_days;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        Iterator() = default;
+
+        [[nodiscard]] value_type operator*() const noexcept { return current_; }
+
+        Iterator& operator++() {
+            word_ &= word_ - 1;
+            settle();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.current_ == rhs.current_;
+        }
+
+        [[nodiscard]] friend bool operator==(const Iterator& it, std::default_sentinel_t) noexcept {
+            return it.current_ == it.to_;
+        }
+
+      private:
+        friend class BusinessDayRange;
+
+        Iterator(const Calendar& calendar, WeekendMask weekend, std::chrono::sys_days from,
+                 std::chrono::sys_days to)
+            : calendar_(&calendar), weekend_(weekend), current_(from), to_(to) {
+            if (from >= to) {
+                current_ = to_;
+                return;
+            }
+            auto day = static_cast<std::int32_t>(from.time_since_epoch().count());
+            load(detail::civilFromDays(day).year);
+            auto index = static_cast<std::size_t>((from - year_start_).count());
+            word_index_ = index / YearBitmap::WORD_BITS;
+            word_ = bitmap_.words()[word_index_] &
+                    (~std::uint64_t{0} << (index % YearBitmap::WORD_BITS));
+            settle();
+        }
+
+        /**
+         * @brief Read the business days of a year and start at its first word
+         */
+        void load(int year) {
+            year_ = year;
+            year_start_ =
+                std::chrono::sys_days{std::chrono::days{detail::daysFromCivil(year, 1, 1)}};
+            if constexpr (BusinessDayCalendar<Calendar>) {
+                bitmap_ = calendar_->getBusinessDayBitmap(year, weekend_);
+            } else {
+                bitmap_ = calendar_->getBusinessDayBitmap(year);
+            }
+            word_index_ = 0;
+            word_ = bitmap_.words()[0];
+        }
+
+        /**
+         * @brief Move to the lowest business day left in word_, or further on, up to the bound
+         */
+        void settle() {
+            while (word_ == 0) {
+                if (++word_index_ < YearBitmap::WORDS) {
+                    word_ = bitmap_.words()[word_index_];
+                } else {
+                    // Stop before reading a year the range does not reach, which a calendar over
+                    // a fixed range of years may not have
+                    if (year_start_ + std::chrono::days{YearBitmap::lengthOf(year_)} >= to_) {
+                        current_ = to_;
+                        return;
+                    }
+                    load(year_ + 1);
+                }
+                // Words starting at or past the bound cannot hold a day of the range
+                if (wordStart() >= to_) {
+                    current_ = to_;
+                    return;
+                }
+            }
+            current_ = wordStart() + std::chrono::days{std::countr_zero(word_)};
+            if (current_ >= to_) {
+                current_ = to_;
+            }
+        }
+
+        [[nodiscard]] std::chrono::sys_days wordStart() const noexcept {
+            return year_start_ + std::chrono::days{word_index_ * YearBitmap::WORD_BITS};
+        }
+
+        const Calendar* calendar_ = nullptr;
+        WeekendMask weekend_;
+        std::chrono::sys_days current_{};
+        std::chrono::sys_days to_{};
+        int year_ = 0;
+        std::chrono::sys_days year_start_{};
+        std::size_t word_index_ = 0;
+
+        // Business days of the current word not visited yet; the lowest set bit is current_
+        std::uint64_t word_ = 0;
+        YearBitmap bitmap_;
+    };
+
+    BusinessDayRange() = default;
+
+    /**
+     * @brief Build a view of the business days in [from, to)
+     * @param from The first day considered
+     * @param to The day after the last day considered; the view is empty unless it is after from
+     * @param calendar The calendar to read business days from; must outlive the view
+     * @param weekend The weekdays considered as weekend; ignored for JointCalendar
+     */
+    BusinessDayRange(std::chrono::sys_days from, std::chrono::sys_days to, const Calendar& calendar,
+                     WeekendMask weekend)
+        : calendar_(&calendar), weekend_(weekend), from_(from), to_(to) {}
+
+    [[nodiscard]] Iterator begin() const { return Iterator(*calendar_, weekend_, from_, to_); }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+  private:
+    const Calendar* calendar_ = nullptr;
+    WeekendMask weekend_;
+    std::chrono::sys_days from_{};
+    std::chrono::sys_days to_{};
+};
+
+/**
+ * @brief Get a lazy view of the business days in [from, to)
+ * @param from The first day considered
+ * @param to The day after the last day considered; the view is empty unless it is after from
+ * @param calendar The calendar to read business days from; must outlive the view
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @throws YearOutOfRangeException on iteration, if the calendar covers a fixed range of years
+ * that the range leaves
+ *
+ * Dates convert implicitly, so year_month_day bounds can be passed as they are.
+ */
+template <BusinessDayCalendar Calendar>
+[[nodiscard]] BusinessDayRange<Calendar>
+businessDays(std::chrono::sys_days from, std::chrono::sys_days to, const Calendar& calendar,
+             WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND) {
+    return {from, to, calendar, weekend};
+}
+
+/**
+ * @brief Get a lazy view of the business days in [from, to) of a joint calendar
+ * @param from The first day considered
+ * @param to The day after the last day considered; the view is empty unless it is after from
+ * @param calendar The joint calendar, whose members carry their own weekends; must outlive the
+ * view
+ */
+[[nodiscard]] inline BusinessDayRange<JointCalendar>
+businessDays(std::chrono::sys_days from, std::chrono::sys_days to, const JointCalendar& calendar) {
+    return {from, to, calendar, SATURDAY_SUNDAY_WEEKEND};
+}
+
+} // namespace datelib
+
+template <typename Calendar>
+inline constexpr bool std::ranges::enable_borrowed_range<datelib::BusinessDayRange<Calendar>> =
+    true;
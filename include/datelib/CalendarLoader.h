@@ -0,0 +1,72 @@
+#pragma once
+
+#include "datelib/exceptions.h"
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <string_view>
+
+namespace datelib {
+
+// Forward declaration
+class HolidayCalendar;
+
+/**
+ * @brief Summary of a calendar definition load
+ */
+struct LoadStatistics {
+    std::size_t bytes = 0;
+    std::size_t lines = 0;
+    std::size_t holidays = 0;
+    std::size_t rules = 0;
+    std::chrono::nanoseconds elapsed{0};
+
+    /**
+     * @brief Get the load throughput in megabytes (10^6 bytes) per second
+     */
+    [[nodiscard]] double megabytesPerSecond() const noexcept {
+        auto seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0.0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Load holiday definitions from a stream of text into a calendar
+ * @param input The definitions, read in large blocks until the end of the stream
+ * @param calendar The calendar to add the holidays and rules to
+ * @return The amount of input processed and the time taken
+ * @throws CalendarParseException if a line is malformed; the calendar is left unchanged
+ * @throws CalendarFileException if the stream fails while reading
+ *
+ * The format has one definition per line, with comma-separated fields. The name is the rest of
+ * the line after the last field before it, so it may itself contain commas:
+ * @code
+ *   # Explicit holiday: date,YYYY-MM-DD,name
+ *   date,2025-01-09,National Day of Mourning
+ *   # Fixed date rule: fixed,month,day,name
+ *   fixed,12,25,Christmas
+ *   # Nth weekday rule: nth,month,weekday (0 = Sunday),occurrence (1-5 or last),name
+ *   nth,11,4,4,Thanksgiving
+ *   nth,5,1,last,Memorial Day
+ *   # Easter-relative rule: easter,days from Easter Sunday,western or orthodox,name
+ *   easter,-2,western,Good Friday
+ * @endcode
+ * Blank lines and lines starting with '#' are ignored, and line endings may be "\n" or "\r\n".
+ *
+ * Lines are parsed in place with std::string_view and std::from_chars. Explicit holidays are
+ * inserted in bulk and their names interned by the calendar, so only a new name costs an
+ * allocation.
+ */
+LoadStatistics loadCalendar(std::istream& input, HolidayCalendar& calendar);
+
+/**
+ * @brief Load holiday definitions held in memory into a calendar
+ * @param text The definitions, in the format described for the stream overload
+ * @param calendar The calendar to add the holidays and rules to
+ * @return The amount of input processed and the time taken
+ * @throws CalendarParseException if a line is malformed; the calendar is left unchanged
+ */
+LoadStatistics loadCalendar(std::string_view text, HolidayCalendar& calendar);
+
+} // namespace datelib
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "datelib/WeekendMask.h"
+#include "datelib/YearBitmap.h"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace datelib {
+
+// Forward declaration
+class HolidayCalendar;
+
+/**
+ * @brief Immutable snapshot of a holiday calendar over a range of years
+ *
+ * A CompiledCalendar is produced by HolidayCalendar::freeze(). Every rule is evaluated once for
+ * every year of the range, and the result is stored as flat arrays: a bitmap per year, the sorted
+ * holiday days, and for each holiday the IDs of its names in the process-wide name table (see
+ * internHolidayName()). Queries are bit tests and binary searches, with no virtual calls, no
+ * allocation (except for returned vectors) and no locking. The snapshot has no mutable state, so
+ * one instance can be shared read-only by any number of threads.
+ *
+ * Queries about years outside the range throw YearOutOfRangeException rather than guessing.
+ *
+ * Example usage:
+ * @code
+ *   const auto compiled = calendar.freeze(2000, 2100);
+ *   // hand a const reference to every worker
+ *   auto settlement = adjust(date, BusinessDayConvention::Following, compiled);
+ * @endcode
+ */
+class CompiledCalendar {
+  public:
+    /**
+     * @brief Get the first year of the range
+     */
+    [[nodiscard]] int firstYear() const noexcept { return first_year_; }
+
+    /**
+     * @brief Get the last year of the range (inclusive)
+     */
+    [[nodiscard]] int lastYear() const noexcept { return last_year_; }
+
+    /**
+     * @brief Check whether a date lies within the range
+     * @param date The date to check
+     */
+    [[nodiscard]] bool contains(const std::chrono::year_month_day& date) const noexcept;
+
+    /**
+     * @brief Check if a given date is a holiday
+     * @param date The date to check
+     * @return true if the date is a holiday, false otherwise (including for invalid dates)
+     * @throws YearOutOfRangeException if a valid date lies outside the range
+     */
+    [[nodiscard]] bool isHoliday(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get all holidays for a given year
+     * @param year The year to get holidays for
+     * @return A sorted vector of all holiday dates in that year
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] std::vector<std::chrono::year_month_day> getHolidays(int year) const;
+
+    /**
+     * @brief Get the names of all holidays on a given date
+     * @param date The date to check
+     * @return A vector of holiday names for that date, in the order their rules were added
+     * @throws YearOutOfRangeException if a valid date lies outside the range
+     */
+    [[nodiscard]] std::vector<std::string>
+    getHolidayNames(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get the name IDs of all holidays on a given date, without allocating
+     * @param date The date to check
+     * @return The IDs, for holidayName(), in the order getHolidayNames() gives the names; empty
+     * unless the date is a holiday. The span refers to the snapshot and is valid as long as the
+     * CompiledCalendar (or a copy sharing its snapshot) is alive
+     * @throws YearOutOfRangeException if a valid date lies outside the range
+     */
+    [[nodiscard]] std::span<const std::uint32_t>
+    getHolidayNameIds(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get the holidays of a year as a bitmap
+     * @param year The year to get holidays for
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] const YearBitmap& getHolidayBitmap(int year) const;
+
+    /**
+     * @brief Get the business days of a year as a bitmap
+     * @param year The year to get business days for
+     * @param weekend The weekdays considered as weekend
+     * @return A bitmap with the bit set for every day of the year that is neither a weekend day
+     * nor a holiday
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] YearBitmap getBusinessDayBitmap(int year, WeekendMask weekend) const;
+
+    /**
+     * @brief Get every holiday of the range as a sorted array of days, without duplicates
+     */
+    [[nodiscard]] std::span<const std::chrono::sys_days> holidays() const noexcept {
+        return holidays_;
+    }
+
+  private:
+    friend class HolidayCalendar;
+
+    /**
+     * @brief Build the snapshot from the (day, name ID) pairs produced by the rules
+     * @param entries Holidays within the range, in the order their rules were added
+     */
+    CompiledCalendar(int first_year, int last_year,
+                     std::vector<std::pair<std::chrono::sys_days, std::uint32_t>> entries);
+
+    /**
+     * @brief Position of a year in bitmaps_
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] std::size_t yearSlot(int year) const;
+
+    int first_year_;
+    int last_year_;
+
+    // One holiday bitmap per year of the range
+    std::vector<YearBitmap> bitmaps_;
+
+    // Every holiday day in ascending order
+    std::vector<std::chrono::sys_days> holidays_;
+
+    // Name IDs of holidays_[i] are name_ids_[name_offsets_[i]] up to (excluding)
+    // name_ids_[name_offsets_[i + 1]]
+    std::vector<std::uint32_t> name_offsets_;
+    std::vector<std::uint32_t> name_ids_;
+};
+
+} // namespace datelib
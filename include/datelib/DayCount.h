@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <span>
+
+namespace datelib {
+
+// Forward declaration
+class BusinessDayIndex;
+
+/**
+ * @brief Day count conventions for converting an accrual period into a fraction of a year
+ */
+enum class DayCountConvention {
+    /**
+     * @brief Actual days in the period divided by 360 (ACT/360)
+     */
+    Actual360,
+
+    /**
+     * @brief Actual days in the period divided by 365 (ACT/365F)
+     */
+    Actual365Fixed,
+
+    /**
+     * @brief 30/360 Bond Basis (ISDA 2006 4.16(f)): a 31st start day counts as the 30th, and a
+     * 31st end day counts as the 30th when the start day is the 30th or 31st
+     */
+    Thirty360,
+
+    /**
+     * @brief 30E/360 Eurobond Basis (ISDA 2006 4.16(g)): every 31st counts as the 30th
+     */
+    ThirtyE360,
+
+    /**
+     * @brief ACT/ACT ISDA: days in leap years divided by 366 plus days in other years divided by
+     * 365
+     */
+    ActualActualISDA,
+
+    /**
+     * @brief Business days in the period divided by 252 (BUS/252); needs a BusinessDayIndex
+     */
+    Business252
+};
+
+/**
+ * @brief Compute the year fraction of an accrual period
+ * @param start The start of the period (counted)
+ * @param end The end of the period (not counted)
+ * @param convention The day count convention; Business252 needs the BusinessDayIndex overload
+ * @return The fraction of a year; negative if end is before start
+ * @throws std::invalid_argument if either date is invalid or the convention is Business252
+ */
+[[nodiscard]] double yearFraction(const std::chrono::year_month_day& start,
+                                  const std::chrono::year_month_day& end,
+                                  DayCountConvention convention);
+
+/**
+ * @brief Compute the BUS/252 year fraction of an accrual period
+ * @param start The start of the period (counted)
+ * @param end The end of the period (not counted)
+ * @param index The business days to count
+ * @return The number of business days in [start, end) divided by 252; negative if end is before
+ * start
+ * @throws std::invalid_argument if either date is invalid
+ */
+[[nodiscard]] double yearFraction(const std::chrono::year_month_day& start,
+                                  const std::chrono::year_month_day& end,
+                                  const BusinessDayIndex& index);
+
+/**
+ * @brief Compute the year fractions of a column of accrual periods
+ * @param starts The start of each period
+ * @param ends The end of each period
+ * @param fractions Receives the fraction of each period, as the scalar overload gives it; must
+ * have the same size as starts and ends
+ * @param convention The day count convention; Business252 needs the BusinessDayIndex overload
+ * @throws std::invalid_argument if the spans differ in size or the convention is Business252
+ *
+ * The convention is dispatched once per call, and each convention is a loop of branch-free
+ * integer arithmetic on day numbers (the civil date conversions of the 30/360 and ACT/ACT
+ * conventions included), which compilers vectorize. On x86-64 CPUs with AVX2 (detected at run
+ * time) the loops are compiled for AVX2; elsewhere the baseline instruction set is used.
+ */
+void yearFractions(std::span<const std::chrono::sys_days> starts,
+                   std::span<const std::chrono::sys_days> ends, std::span<double> fractions,
+                   DayCountConvention convention);
+
+/**
+ * @brief Compute the BUS/252 year fractions of a column of accrual periods
+ * @param starts The start of each period
+ * @param ends The end of each period
+ * @param fractions Receives the fraction of each period; must have the same size as starts and
+ * ends
+ * @param index The business days to count
+ * @throws std::invalid_argument if the spans differ in size
+ *
+ * Business days are counted with BusinessDayIndex::businessDaysBetween(), which is a difference
+ * of two prefix counts for periods inside the index horizon.
+ */
+void yearFractions(std::span<const std::chrono::sys_days> starts,
+                   std::span<const std::chrono::sys_days> ends, std::span<double> fractions,
+                   const BusinessDayIndex& index);
+
+} // namespace datelib
@@ -1,43 +1,112 @@
 #pragma once
 
+#include "datelib/CompiledCalendar.h"
+#include "datelib/HolidayNames.h"
 #include "datelib/HolidayRule.h"
+#include "datelib/WeekendMask.h"
+#include "datelib/YearBitmap.h"
+#include "datelib/detail/year_cache.h"
 
 #include <chrono>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace datelib {
 
+/**
+ * @brief A holiday date with one of its names, as visited by HolidayCalendar::forEachHoliday()
+ *
+ * The name is a view of the process-wide name table (see internHolidayName()), so it stays valid
+ * for the lifetime of the process, after the calendar is modified or destroyed.
+ */
+struct Holiday {
+    std::chrono::year_month_day date;
+    std::string_view name;
+
+    // ID of the name in the process-wide name table (see internHolidayName())
+    std::uint32_t name_id;
+
+    friend bool operator==(const Holiday&, const Holiday&) = default;
+};
+
 /**
  * @brief A calendar that manages holidays using rule-based generation
+ *
+ * The rules for a year are evaluated once, the first time any date in that year is queried, and
+ * the result is kept as a YearBitmap. Subsequent queries for the same year are bit tests on the
+ * cached bitmap: years already built are found without taking a lock, so const queries may run
+ * concurrently without contending, and only the first query of a year waits for it to be built.
+ * Adding a holiday or a rule discards every cached year.
+ *
+ * Explicit holidays added with addHoliday() or addHolidays() are not stored as rules but in a
+ * flat array sorted by day, with the IDs of their names, so a calendar can carry tens of thousands
+ * of one-off dates: building a year is a binary search plus the dates of that year. The array is
+ * sorted lazily, on the first query after holidays were added, so loading dates in any order is
+ * linear apart from that one sort.
+ *
+ * Rules of the built-in types (FixedDateRule, NthWeekdayRule, ExplicitDateRule, EasterOffsetRule)
+ * are stored by value in one contiguous array and evaluated without virtual calls. Rules of any
+ * other type, including classes derived from the built-in ones, are kept behind a pointer and
+ * called through the HolidayRule interface.
+ *
+ * An ObservedRule may place the holiday of one year in another: New Year's Day on a Saturday is
+ * observed on the Friday before. Observed rules are also evaluated for the two adjacent years
+ * when a year is built, so an observed date is a holiday of the year it falls in and costs
+ * nothing more to query than any other holiday. Dates other rules place outside the year they
+ * are evaluated for are ignored.
+ *
+ * Rules and cached years are shared between copies (copy-on-write): copying a calendar is a
+ * reference count increment, and a copy only takes its own rule list, with an empty cache, the
+ * first time addRule() or addHoliday() is called on it. Rules of other types are immutable once
+ * added, so the copy shares them rather than cloning them. Copies used on different threads
+ * share cached years without contending: only building a year not yet cached takes the shared
+ * lock.
+ *
+ * Modifying a calendar requires exclusive access to it and exclusion from all of its copies.
+ * Whether the state is still shared is decided from its reference count (the pattern that made
+ * std::shared_ptr::unique() deprecated), so while addRule() or addHoliday() runs, no other thread
+ * may copy or destroy a calendar sharing its state. Querying those copies meanwhile is safe.
+ *
+ * Names of rules and explicit holidays are kept as IDs in the process-wide name table (see
+ * internHolidayName()), so a name shared by many dates, rules or calendars is stored once.
+ * getHolidayNameIds() and forEachHoliday() hand names out as IDs and views without copying them.
  */
 class HolidayCalendar {
   public:
     /**
      * @brief Construct an empty holiday calendar
      */
-    HolidayCalendar() = default;
+    HolidayCalendar() noexcept;
 
     /**
-     * @brief Copy constructor
+     * @brief Copy constructor (shares the rules of other until either calendar is modified)
      */
-    HolidayCalendar(const HolidayCalendar& other);
+    HolidayCalendar(const HolidayCalendar& other) noexcept = default;
 
     /**
-     * @brief Copy assignment operator
+     * @brief Copy assignment operator (shares the rules of other until either calendar is
+     * modified)
      */
-    HolidayCalendar& operator=(const HolidayCalendar& other);
+    HolidayCalendar& operator=(const HolidayCalendar& other) noexcept = default;
 
     /**
-     * @brief Move constructor
+     * @brief Move constructor (leaves other empty)
      */
-    HolidayCalendar(HolidayCalendar&& other) noexcept = default;
+    HolidayCalendar(HolidayCalendar&& other) noexcept;
 
     /**
-     * @brief Move assignment operator
+     * @brief Move assignment operator (leaves other empty)
      */
-    HolidayCalendar& operator=(HolidayCalendar&& other) noexcept = default;
+    HolidayCalendar& operator=(HolidayCalendar&& other) noexcept;
 
     /**
      * @brief Destructor
@@ -51,9 +120,29 @@ class HolidayCalendar {
      */
     void addHoliday(const std::string& name, const std::chrono::year_month_day& date);
 
+    /**
+     * @brief Add many explicit holiday dates sharing one name
+     * @param name The name of the holidays
+     * @param dates The dates to mark as holidays
+     * @throws std::invalid_argument if any date is invalid; no date is added in that case
+     */
+    void addHolidays(const std::string& name, std::span<const std::chrono::year_month_day> dates);
+
+    /**
+     * @brief Add many explicit holiday dates, each with its own name
+     * @param holidays Pairs of holiday name and date, in the order they should be added
+     * @throws std::invalid_argument if any date is invalid; no date is added in that case
+     *
+     * Names already known to the calendar are looked up without being copied, so loading many
+     * dates that share few names allocates only for the dates themselves.
+     */
+    void addHolidays(
+        std::span<const std::pair<std::string_view, std::chrono::year_month_day>> holidays);
+
     /**
      * @brief Add a rule for generating holidays
      * @param rule The holiday rule to add (ownership is transferred)
+     * @throws std::invalid_argument if rule is null
      */
     void addRule(std::unique_ptr<HolidayRule> rule);
 
@@ -74,12 +163,183 @@ class HolidayCalendar {
     /**
      * @brief Get the names of all holidays on a given date
      * @param date The date to check
-     * @return A vector of holiday names for that date
+     * @return A vector of holiday names for that date: names from rules, in the order the rules
+     * were added, then names of explicit holidays, in the order they were added
      */
     std::vector<std::string> getHolidayNames(const std::chrono::year_month_day& date) const;
 
+    /**
+     * @brief Write the name IDs of all holidays on a given date
+     * @param date The date to check
+     * @param out Receives the IDs, for holidayName(), in the order getHolidayNames() gives the
+     * names; nothing is written unless the date is a holiday
+     * @return The output iterator past the last ID written
+     */
+    template <std::output_iterator<std::uint32_t> Output>
+    Output getHolidayNameIds(const std::chrono::year_month_day& date, Output out) const {
+        if (isHoliday(date)) {
+            forEachHoliday(date, std::chrono::sys_days{date} + std::chrono::days{1},
+                           [&out](const Holiday& holiday) { *out++ = holiday.name_id; });
+        }
+        return out;
+    }
+
+    /**
+     * @brief Visit every holiday in a range of dates, with its names, in date order
+     * @param from The first date of the range
+     * @param to The date after the last date of the range
+     * @param function Callable taking a const Holiday&, called once per name of each holiday:
+     * dates ascending, and on each date the names in the order getHolidayNames() gives them
+     * @throws std::invalid_argument if either date is invalid
+     *
+     * The rules are evaluated once per year of the range and their dates merged with the explicit
+     * holidays, which are already sorted, so a long range costs about as much as the holidays it
+     * holds. The rule dates of a year go into a buffer on the stack, reused for every year, and
+     * names are views of the process-wide name table, so nothing is allocated per year or per
+     * holiday. The stack buffer holds 64 rule dates; a calendar placing more in one year grows
+     * the buffer on the heap, and that memory is reused for the rest of the call. The function
+     * must not modify the calendar.
+     */
+    template <typename Function>
+    void forEachHoliday(const std::chrono::year_month_day& from,
+                        const std::chrono::year_month_day& to, Function&& function) const {
+        using Callable = std::remove_reference_t<Function>;
+        visitHolidays(
+            from, to,
+            [](const void* context, const Holiday& holiday) {
+                (*static_cast<Callable*>(const_cast<void*>(context)))(holiday);
+            },
+            std::addressof(function));
+    }
+
+    /**
+     * @brief Write every holiday in a range of dates, with its names, in date order
+     * @param from The first date of the range
+     * @param to The date after the last date of the range
+     * @param out Receives one Holiday per name of each holiday, in the order forEachHoliday()
+     * visits them
+     * @return The output iterator past the last holiday written
+     * @throws std::invalid_argument if either date is invalid
+     */
+    template <std::output_iterator<const Holiday&> Output>
+    Output getHolidays(const std::chrono::year_month_day& from,
+                       const std::chrono::year_month_day& to, Output out) const {
+        forEachHoliday(from, to, [&out](const Holiday& holiday) { *out++ = holiday; });
+        return out;
+    }
+
+    /**
+     * @brief Get the holidays of a year as a bitmap
+     * @param year The year to get holidays for
+     * @return A bitmap with the bit set for every holiday in that year, valid until the calendar
+     * is modified or destroyed
+     */
+    [[nodiscard]] const YearBitmap& getHolidayBitmap(int year) const;
+
+    /**
+     * @brief Get the business days of a year as a bitmap
+     * @param year The year to get business days for
+     * @param weekend The weekdays considered as weekend
+     * @return A bitmap with the bit set for every day of the year that is neither a weekend day
+     * nor a holiday
+     */
+    [[nodiscard]] YearBitmap getBusinessDayBitmap(int year, WeekendMask weekend) const;
+
+    /**
+     * @brief Evaluate every rule over a range of years into an immutable snapshot
+     * @param from_year The first year of the snapshot
+     * @param to_year The last year of the snapshot (inclusive)
+     * @return A CompiledCalendar answering the same queries for dates within the range
+     * @throws std::invalid_argument if to_year is before from_year
+     *
+     * The snapshot does not refer back to this calendar: later changes to the calendar are not
+     * reflected in it.
+     */
+    [[nodiscard]] CompiledCalendar freeze(int from_year, int to_year) const;
+
   private:
-    std::vector<std::unique_ptr<HolidayRule>> rules_;
+    /**
+     * @brief An explicit holiday: a day and the ID of its name in the process-wide name table
+     */
+    struct ExplicitHoliday {
+        std::chrono::sys_days day;
+        std::uint32_t name_id;
+    };
+
+    /**
+     * @brief A rule as stored by the calendar: built-in rules by value, other rules by pointer
+     */
+    using StoredRule = std::variant<FixedDateRule, NthWeekdayRule, ExplicitDateRule,
+                                    EasterOffsetRule, std::shared_ptr<const HolidayRule>>;
+
+    /**
+     * @brief Rules and lazily populated holiday bitmaps, shared by copies of a calendar
+     *
+     * A State is never modified while shared: mutators first detach through mutableState().
+     */
+    struct State {
+        std::vector<StoredRule> rules;
+
+        // Name ID of each rule, taken when it is added
+        std::vector<std::uint32_t> rule_name_ids;
+
+        // Explicit holidays; sorted by day (stably, keeping insertion order within a day) only
+        // when explicit_sorted is set, which is guarded by mutex
+        std::vector<ExplicitHoliday> explicit_holidays;
+        bool explicit_sorted = true;
+
+        std::mutex mutex;
+
+        // Holiday bitmaps of the years queried so far; found again without taking a lock
+        detail::YearCache years;
+    };
+
+    /**
+     * @brief Move a rule into storage, by value if its type is exactly a built-in rule type
+     */
+    [[nodiscard]] static StoredRule storeRule(std::unique_ptr<HolidayRule> rule);
+
+    /**
+     * @brief The state shared by every calendar without rules
+     */
+    [[nodiscard]] static const std::shared_ptr<State>& emptyState() noexcept;
+
+    /**
+     * @brief Get a state owned by this calendar alone, with its cache discarded, ready for a
+     * change to the rules
+     *
+     * Decides from the reference count whether to detach, so no calendar sharing the state may
+     * be copied or destroyed concurrently.
+     */
+    State& mutableState();
+
+    /**
+     * @brief Evaluate every rule and explicit holiday for a year; requires sorted explicit
+     * holidays
+     */
+    [[nodiscard]] YearBitmap buildBitmap(int year) const;
+
+    /**
+     * @brief Sort the explicit holidays by day if holidays were added since the last sort;
+     * requires state_->mutex
+     */
+    void sortExplicitHolidays() const;
+
+    /**
+     * @brief Get the explicit holidays in [from, to); requires sorted explicit holidays
+     */
+    [[nodiscard]] std::span<const ExplicitHoliday>
+    explicitHolidaysIn(std::chrono::sys_days from, std::chrono::sys_days to) const;
+
+    /**
+     * @brief Implementation of forEachHoliday(), calling visit(context, holiday) for each holiday
+     */
+    void visitHolidays(const std::chrono::year_month_day& from,
+                       const std::chrono::year_month_day& to,
+                       void (*visit)(const void* context, const Holiday& holiday),
+                       const void* context) const;
+
+    std::shared_ptr<State> state_;
 };
 
 } // namespace datelib
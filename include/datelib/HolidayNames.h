@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace datelib {
+
+/**
+ * @brief Get the ID of a holiday name in the process-wide name table, adding it if needed
+ * @param name The name to intern
+ * @return The ID of the name; equal names always get the same ID
+ * @throws std::length_error if the table is full (4,194,304 distinct names)
+ *
+ * Rules, calendars and compiled calendars refer to names by ID, so a name shared by many rules,
+ * explicit dates and calendars is stored once. Interning takes a lock; reading a name back with
+ * holidayName() does not.
+ *
+ * The table is append-only and lives as long as the process: a name stays in it after every rule
+ * and calendar using it is destroyed. Each distinct name costs its characters plus roughly 100
+ * bytes of bookkeeping, and index blocks of 1024 IDs (16 KiB) are allocated as the table grows.
+ * Memory therefore grows with the number of distinct names ever interned, not with the calendars
+ * alive, so a process building calendars from an open-ended source of names (for example one
+ * name per generated closure) should reuse names rather than make each one unique.
+ */
+[[nodiscard]] std::uint32_t internHolidayName(std::string_view name);
+
+/**
+ * @brief Get the holiday name with a given ID
+ * @param id An ID returned by internHolidayName()
+ * @return The name, valid for the lifetime of the process
+ * @throws std::out_of_range if no name has that ID
+ */
+[[nodiscard]] std::string_view holidayName(std::uint32_t id);
+
+/**
+ * @brief Get the number of distinct holiday names interned so far
+ */
+[[nodiscard]] std::size_t holidayNameCount() noexcept;
+
+} // namespace datelib
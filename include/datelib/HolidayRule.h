@@ -1,17 +1,17 @@
 #pragma once
 
+#include "datelib/HolidayNames.h"
+#include "datelib/RuleDates.h"
+
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace datelib {
 
-/**
- * @brief Enum for specifying occurrence of a weekday in a month
- */
-enum class Occurrence { First = 1, Second = 2, Third = 3, Fourth = 4, Fifth = 5, Last = -1 };
-
 /**
  * @brief Abstract base class for holiday calculation rules
  */
@@ -35,12 +35,36 @@ class HolidayRule {
      */
     virtual std::chrono::year_month_day calculateDate(int year) const = 0;
 
+    /**
+     * @brief Calculate the holiday date for a given year, if the rule applies to that year
+     * @param year The year to calculate the holiday for
+     * @return The date of the holiday in that year, or std::nullopt if the rule does not apply
+     *
+     * This fuses appliesTo() and calculateDate() into one call that never throws, and is what
+     * HolidayCalendar uses to evaluate rules. The default implementation calls both and maps an
+     * exception from either to std::nullopt; the built-in rules override it with a single
+     * computation. Custom rules should override it when the two steps share work. A class derived
+     * from a built-in rule that overrides appliesTo() or calculateDate() keeps working without
+     * overriding tryCalculate(): the built-in versions defer to the default implementation for
+     * derived types.
+     */
+    virtual std::optional<std::chrono::year_month_day> tryCalculate(int year) const noexcept;
+
     /**
      * @brief Get the name of this holiday
      * @return The holiday name
      */
     virtual std::string getName() const = 0;
 
+    /**
+     * @brief Get the ID of this holiday's name in the process-wide name table
+     * @return An ID for holidayName(); equal names have equal IDs
+     *
+     * The default implementation interns getName(). The built-in rules intern their name once,
+     * when they are constructed, store only the ID, and return it here.
+     */
+    virtual std::uint32_t getNameId() const;
+
     /**
      * @brief Clone this rule
      * @return A unique pointer to a copy of this rule
@@ -53,17 +77,19 @@ class HolidayRule {
  *
  * ExplicitDateRule represents a one-time or non-recurring holiday on a specific date.
  * Unlike FixedDateRule which recurs annually, ExplicitDateRule only applies to the
- * exact year specified in the date.
+ * exact year specified in the date. HolidayCalendar::addHoliday() does not create these rules:
+ * it keeps explicit dates in an index of its own, which scales to many thousands of dates.
  *
  * Example usage:
  * @code
  *   // Add a one-time holiday for a solar eclipse in 2024
- *   calendar.addHoliday("Solar Eclipse", year_month_day{year{2024}, month{4}, day{8}});
+ *   calendar.addRule(std::make_unique<ExplicitDateRule>(
+ *       "Solar Eclipse", year_month_day{year{2024}, month{4}, day{8}}));
  *
- *   // Multiple explicit holidays can be added for the same year
+ *   // Same effect, stored in the calendar's explicit holiday index
  *   calendar.addHoliday("Company Anniversary", year_month_day{year{2024}, month{6}, day{15}});
  *
- *   // Each ExplicitDateRule only applies to its specific year
+ *   // An explicit date only applies to its specific year
  *   calendar.isHoliday(year_month_day{year{2024}, month{4}, day{8}}); // true
  *   calendar.isHoliday(year_month_day{year{2025}, month{4}, day{8}}); // false
  * @endcode
@@ -90,17 +116,22 @@ class ExplicitDateRule : public HolidayRule {
      */
     bool appliesTo(int year) const override;
     std::chrono::year_month_day calculateDate(int year) const override;
-    std::string getName() const override { return name_; }
+    std::optional<std::chrono::year_month_day> tryCalculate(int year) const noexcept override;
+    std::string getName() const override { return std::string(holidayName(name_id_)); }
+    std::uint32_t getNameId() const override;
     std::unique_ptr<HolidayRule> clone() const override;
 
   private:
-    std::string name_;
-    std::chrono::year_month_day date_;
+    std::uint32_t name_id_;
+    ExplicitDate date_;
 };
 
 /**
  * @brief Rule for holidays that occur on a fixed date each year
  * Example: Christmas (December 25), New Year's Day (January 1)
+ *
+ * The date calculation is done by FixedDate, which can also be used on its own to build a
+ * StaticCalendar at compile time.
  */
 class FixedDateRule : public HolidayRule {
   public:
@@ -114,13 +145,14 @@ class FixedDateRule : public HolidayRule {
 
     bool appliesTo(int year) const override;
     std::chrono::year_month_day calculateDate(int year) const override;
-    std::string getName() const override { return name_; }
+    std::optional<std::chrono::year_month_day> tryCalculate(int year) const noexcept override;
+    std::string getName() const override { return std::string(holidayName(name_id_)); }
+    std::uint32_t getNameId() const override;
     std::unique_ptr<HolidayRule> clone() const override;
 
   private:
-    std::string name_;
-    std::chrono::month month_;
-    std::chrono::day day_;
+    std::uint32_t name_id_;
+    FixedDate date_;
 };
 
 /**
@@ -141,14 +173,99 @@ class NthWeekdayRule : public HolidayRule {
 
     bool appliesTo(int year) const override;
     std::chrono::year_month_day calculateDate(int year) const override;
-    std::string getName() const override { return name_; }
+    std::optional<std::chrono::year_month_day> tryCalculate(int year) const noexcept override;
+    std::string getName() const override { return std::string(holidayName(name_id_)); }
+    std::uint32_t getNameId() const override;
+    std::unique_ptr<HolidayRule> clone() const override;
+
+  private:
+    std::uint32_t name_id_;
+    NthWeekday date_;
+};
+
+/**
+ * @brief Rule for holidays a fixed number of days before or after Easter Sunday
+ * Example: Good Friday (-2), Easter Monday (1), Ascension Day (39), Whit Monday (50)
+ *
+ * Easter is looked up in a table computed at compile time, covering the years 1583 to 4099; the
+ * rule does not apply to other years. The date calculation is done by EasterOffset, which can
+ * also be used on its own to build a StaticCalendar.
+ */
+class EasterOffsetRule : public HolidayRule {
+  public:
+    /**
+     * @brief Construct an Easter-relative holiday rule
+     * @param name The name of the holiday
+     * @param offset_days Days from Easter Sunday (-366 to 366)
+     * @param type Which Easter the offset is relative to
+     * @throws std::invalid_argument if the offset or the type is out of range
+     */
+    EasterOffsetRule(std::string name, int offset_days, EasterType type = EasterType::Western);
+
+    bool appliesTo(int year) const override;
+    std::chrono::year_month_day calculateDate(int year) const override;
+    std::optional<std::chrono::year_month_day> tryCalculate(int year) const noexcept override;
+    std::string getName() const override { return std::string(holidayName(name_id_)); }
+    std::uint32_t getNameId() const override;
+    std::unique_ptr<HolidayRule> clone() const override;
+
+  private:
+    std::uint32_t name_id_;
+    EasterOffset date_;
+};
+
+/**
+ * @brief Rule that moves the date of another rule according to an observance
+ * Example: New Year's Day observed on the nearest weekday
+ *
+ * The wrapped rule gives the actual holiday; the observance moves it off the weekend. The
+ * observed date of a year's holiday may fall in the previous or the next year, so calculateDate()
+ * and tryCalculate() may return a date outside the year asked for. HolidayCalendar accounts for
+ * this when it builds a year, so such dates are holidays of the year they fall in.
+ *
+ * Example usage:
+ * @code
+ *   calendar.addRule(std::make_unique<ObservedRule>(
+ *       std::make_unique<FixedDateRule>("New Year's Day", 1, 1)));
+ *
+ *   // January 1st, 2022 is a Saturday: observed on Friday, December 31st, 2021
+ *   calendar.isHoliday(year_month_day{year{2021}, month{12}, day{31}}); // true
+ * @endcode
+ */
+class ObservedRule : public HolidayRule {
+  public:
+    /**
+     * @brief Construct an observed holiday rule
+     * @param rule The rule giving the actual holiday date
+     * @param observance The days to move the holiday by, depending on its weekday
+     * @throws std::invalid_argument if rule is null
+     */
+    explicit ObservedRule(std::unique_ptr<HolidayRule> rule,
+                          Observance observance = NEAREST_WEEKDAY_OBSERVANCE);
+
+    bool appliesTo(int year) const override;
+
+    /**
+     * @brief Calculate the observed date of the holiday of a given year
+     * @param year The year of the actual holiday
+     * @return The observed date, which may lie in the previous or the next year
+     * @throws std::exception if the wrapped rule does not apply to this year
+     */
+    std::chrono::year_month_day calculateDate(int year) const override;
+    std::optional<std::chrono::year_month_day> tryCalculate(int year) const noexcept override;
+    std::string getName() const override { return rule_->getName(); }
+    std::uint32_t getNameId() const override;
     std::unique_ptr<HolidayRule> clone() const override;
 
+    /**
+     * @brief Get the observance applied to the wrapped rule
+     */
+    [[nodiscard]] const Observance& observance() const noexcept { return observance_; }
+
   private:
-    std::string name_;
-    std::chrono::month month_;
-    std::chrono::weekday weekday_;
-    Occurrence occurrence_;
+    // Immutable once wrapped, so clones share it
+    std::shared_ptr<const HolidayRule> rule_;
+    Observance observance_;
 };
 
 } // namespace datelib
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "datelib/HolidayCalendar.h"
+#include "datelib/WeekendMask.h"
+#include "datelib/YearBitmap.h"
+#include "datelib/detail/year_cache.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace datelib {
+
+/**
+ * @brief How a JointCalendar combines the business days of its calendars
+ */
+enum class JoinRule {
+    /**
+     * @brief A day is a business day only if it is a business day in every calendar (a holiday
+     * in any calendar is a holiday of the joint calendar)
+     */
+    JoinHolidays,
+
+    /**
+     * @brief A day is a business day if it is a business day in at least one calendar
+     */
+    JoinBusinessDays
+};
+
+/**
+ * @brief Combination of several holiday calendars, each with its own weekend
+ *
+ * The business days of a year are computed from the per-year bitmaps of the underlying
+ * calendars: each calendar's holiday bitmap is merged with its weekend, and the results are
+ * combined word by word with AND (JoinHolidays) or OR (JoinBusinessDays). The combined bitmap is
+ * cached per year, in the same way as a HolidayCalendar caches its years, so only the first query
+ * of a year costs a pass over the calendars; later checks of a day are a bit test however many
+ * calendars are joined. Adding a calendar discards the cached years.
+ *
+ * The calendars are held by value. HolidayCalendar copies share their rules and cached years, so
+ * adding a calendar is cheap, and later changes to the original do not affect the joint calendar.
+ * Copies of a joint calendar share its cached years until a calendar is added to one of them.
+ * A joint calendar without calendars treats every day as a business day.
+ *
+ * Example usage:
+ * @code
+ *   JointCalendar settlement(JoinRule::JoinHolidays);
+ *   settlement.add(new_york);
+ *   settlement.add(dubai, FRIDAY_SATURDAY_WEEKEND);
+ *   auto value_date = adjust(trade_date, BusinessDayConvention::Following, settlement);
+ * @endcode
+ */
+class JointCalendar {
+  public:
+    /**
+     * @brief Construct a joint calendar without calendars
+     * @param rule How the business days of the calendars are combined
+     */
+    explicit JointCalendar(JoinRule rule = JoinRule::JoinHolidays) noexcept : rule_(rule) {}
+
+    /**
+     * @brief Add a calendar
+     * @param calendar The calendar to add
+     * @param weekend The weekdays considered as weekend in that calendar
+     */
+    void add(const HolidayCalendar& calendar, WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+    /**
+     * @brief Get how the business days of the calendars are combined
+     */
+    [[nodiscard]] JoinRule rule() const noexcept { return rule_; }
+
+    /**
+     * @brief Get the number of calendars
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return members_.size(); }
+
+    /**
+     * @brief Check if a given date is a business day of the joint calendar
+     * @param date The date to check
+     * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+     */
+    [[nodiscard]] bool isBusinessDay(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get the business days of a year as a bitmap
+     * @param year The year to get business days for
+     * @return A bitmap with the bit set for every business day of the joint calendar
+     */
+    [[nodiscard]] YearBitmap getBusinessDayBitmap(int year) const;
+
+  private:
+    /**
+     * @brief Combine the business days of the calendars for a year
+     */
+    [[nodiscard]] YearBitmap combine(int year) const;
+
+    /**
+     * @brief A calendar and its weekend
+     */
+    struct Member {
+        HolidayCalendar calendar;
+        WeekendMask weekend;
+    };
+
+    JoinRule rule_;
+    std::vector<Member> members_;
+
+    // Combined business days of the years queried so far; null while there are no calendars
+    std::shared_ptr<const detail::YearCache> years_;
+};
+
+} // namespace datelib
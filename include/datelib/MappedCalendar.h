@@ -0,0 +1,186 @@
+#pragma once
+
+#include "datelib/WeekendMask.h"
+#include "datelib/YearBitmap.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace datelib {
+
+// Forward declaration
+class CompiledCalendar;
+
+/**
+ * @brief Write a compiled calendar to a binary calendar file
+ * @param calendar The calendar to write
+ * @param path The file to create or replace
+ * @throws CalendarFileException if the file cannot be written, or if it was replaced but its
+ * directory could not be synced afterwards (the new file is then in place, but the rename may
+ * not survive a crash)
+ *
+ * The file is written under a unique temporary name next to its destination, flushed to disk and
+ * renamed into place, and the directory is flushed after the rename. Processes that have the
+ * previous version mapped keep reading consistent data, concurrent writers of the same path do
+ * not interfere (the last rename wins), and after a crash the path holds either the previous or
+ * the new file. The file is created with mode 0644 whatever the process umask.
+ *
+ * File format (version 1). Every integer is little-endian; sections follow each other in this
+ * order, each starting at a multiple of 8 bytes (padding is zero):
+ * - Header (48 bytes): the magic "DATELIBC", u32 version, i32 first year, i32 last year,
+ *   u32 holiday count H, u32 name reference count R, u32 name count N, u32 name bytes B,
+ *   u32 reserved (0), u64 file size
+ * - Holiday bitmaps: 6 u64 words per year of the range (see YearBitmap::words())
+ * - Holidays: H i32 day numbers (days since 1970-01-01), ascending and distinct
+ * - Name offsets: H + 1 u32; the names of holiday i are references [offset i, offset i + 1)
+ * - Name references: R u32 indexes into the name table
+ * - Name table offsets: N + 1 u32; name j is bytes [offset j, offset j + 1) of the name bytes
+ * - Name bytes: B bytes of UTF-8 text, without terminators
+ */
+void writeCalendarFile(const CompiledCalendar& calendar, const std::filesystem::path& path);
+
+/**
+ * @brief Read-only calendar answering queries directly from a memory-mapped calendar file
+ *
+ * Opening a file maps it and checks its header and section sizes; nothing is parsed or copied, so
+ * opening is O(1) in the size of the calendar. Queries read the mapped pages in place, and
+ * processes mapping the same file share them through the page cache. The answers are those of
+ * the CompiledCalendar the file was written from, including YearOutOfRangeException for years
+ * outside the range.
+ *
+ * The mapping is private and read-only. Replacing the file with writeCalendarFile() does not
+ * affect calendars already open; truncating it in place does, so always replace such files by
+ * renaming.
+ *
+ * Example usage:
+ * @code
+ *   // Once, at build or deployment time
+ *   writeCalendarFile(calendar.freeze(2000, 2100), "us.cal");
+ *
+ *   // In every worker process
+ *   MappedCalendar us_calendar{"us.cal"};
+ *   auto settlement = adjust(date, BusinessDayConvention::Following, us_calendar);
+ * @endcode
+ */
+class MappedCalendar {
+  public:
+    /**
+     * @brief Map a calendar file
+     * @param path The file to map
+     * @throws CalendarFileException if the file cannot be opened or is not a valid calendar file
+     */
+    explicit MappedCalendar(const std::filesystem::path& path);
+
+    MappedCalendar(const MappedCalendar&) = delete;
+    MappedCalendar& operator=(const MappedCalendar&) = delete;
+    MappedCalendar(MappedCalendar&& other) noexcept;
+    MappedCalendar& operator=(MappedCalendar&& other) noexcept;
+    ~MappedCalendar();
+
+    /**
+     * @brief Get the first year of the range
+     */
+    [[nodiscard]] int firstYear() const noexcept { return first_year_; }
+
+    /**
+     * @brief Get the last year of the range (inclusive)
+     */
+    [[nodiscard]] int lastYear() const noexcept { return last_year_; }
+
+    /**
+     * @brief Check whether a date lies within the range
+     * @param date The date to check
+     */
+    [[nodiscard]] bool contains(const std::chrono::year_month_day& date) const noexcept;
+
+    /**
+     * @brief Check if a given date is a holiday
+     * @param date The date to check
+     * @return true if the date is a holiday, false otherwise (including for invalid dates)
+     * @throws YearOutOfRangeException if a valid date lies outside the range
+     */
+    [[nodiscard]] bool isHoliday(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get all holidays for a given year
+     * @param year The year to get holidays for
+     * @return A sorted vector of all holiday dates in that year
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] std::vector<std::chrono::year_month_day> getHolidays(int year) const;
+
+    /**
+     * @brief Get the names of all holidays on a given date
+     * @param date The date to check
+     * @return A vector of holiday names for that date, in the order their rules were added
+     * @throws YearOutOfRangeException if a valid date lies outside the range
+     * @throws CalendarFileException if the name sections of the file are inconsistent
+     */
+    [[nodiscard]] std::vector<std::string>
+    getHolidayNames(const std::chrono::year_month_day& date) const;
+
+    /**
+     * @brief Get the holidays of a year as a bitmap
+     * @param year The year to get holidays for
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] YearBitmap getHolidayBitmap(int year) const;
+
+    /**
+     * @brief Get the business days of a year as a bitmap
+     * @param year The year to get business days for
+     * @param weekend The weekdays considered as weekend
+     * @return A bitmap with the bit set for every day of the year that is neither a weekend day
+     * nor a holiday
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] YearBitmap getBusinessDayBitmap(int year, WeekendMask weekend) const;
+
+  private:
+    /**
+     * @brief Position of a year in the bitmap section
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] std::size_t yearSlot(int year) const;
+
+    /**
+     * @brief Position of a holiday day in the holiday section, or the holiday count if absent
+     */
+    [[nodiscard]] std::uint32_t findHoliday(std::chrono::sys_days day) const noexcept;
+
+    /**
+     * @brief Read a name from the name table
+     * @throws CalendarFileException if its offsets are inconsistent
+     */
+    [[nodiscard]] std::string nameAt(std::uint32_t id) const;
+
+    /**
+     * @brief Unmap the file, if mapped
+     */
+    void unmap() noexcept;
+
+    // The mapping
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    int first_year_ = 0;
+    int last_year_ = 0;
+    std::uint32_t holiday_count_ = 0;
+    std::uint32_t name_ref_count_ = 0;
+    std::uint32_t name_count_ = 0;
+    std::uint32_t name_bytes_ = 0;
+
+    // Start of each section within the mapping
+    const std::byte* bitmaps_ = nullptr;
+    const std::byte* holidays_ = nullptr;
+    const std::byte* name_offsets_ = nullptr;
+    const std::byte* name_refs_ = nullptr;
+    const std::byte* name_table_ = nullptr;
+    const std::byte* name_chars_ = nullptr;
+};
+
+} // namespace datelib
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace datelib {
+
+/**
+ * @brief Public operations whose calls and latencies are recorded in QueryStats
+ */
+enum class StatsOperation {
+    /**
+     * @brief isHoliday() of HolidayCalendar, CompiledCalendar and MappedCalendar
+     */
+    IsHoliday,
+
+    /**
+     * @brief getHolidays() for a year, of HolidayCalendar, CompiledCalendar and MappedCalendar
+     */
+    GetHolidays,
+
+    /**
+     * @brief The scalar isBusinessDay() functions
+     */
+    IsBusinessDay,
+
+    /**
+     * @brief The scalar adjust() functions, one operation per BusinessDayConvention
+     */
+    AdjustFollowing,
+    AdjustModifiedFollowing,
+    AdjustPreceding,
+    AdjustModifiedPreceding,
+    AdjustUnadjusted
+};
+
+// Number of StatsOperation values
+inline constexpr std::size_t STATS_OPERATION_COUNT = 8;
+
+/**
+ * @brief Get the name of an operation, for labelling exported metrics
+ * @return A name such as "isHoliday" or "adjust.ModifiedFollowing"
+ */
+[[nodiscard]] std::string_view statsOperationName(StatsOperation operation) noexcept;
+
+/**
+ * @brief Distribution of recorded values in power-of-two buckets
+ *
+ * Bucket 0 counts values of 0 and bucket i counts values from 2^(i-1) up to 2^i - 1; the last
+ * bucket also takes every larger value.
+ */
+struct Histogram {
+    static constexpr std::size_t BUCKETS = 32;
+
+    // Number of values recorded
+    std::uint64_t count = 0;
+
+    // Sum of the values recorded
+    std::uint64_t sum = 0;
+
+    // Largest value recorded
+    std::uint64_t max = 0;
+
+    std::array<std::uint64_t, BUCKETS> buckets{};
+
+    /**
+     * @brief Get the smallest value counted in a bucket
+     */
+    [[nodiscard]] static constexpr std::uint64_t bucketLowerBound(std::size_t bucket) noexcept {
+        return bucket == 0 ? 0 : std::uint64_t{1} << (bucket - 1);
+    }
+
+    friend bool operator==(const Histogram&, const Histogram&) = default;
+};
+
+/**
+ * @brief Snapshot of the statistics recorded by the library
+ *
+ * Statistics are only recorded when the library is built with the DATELIB_ENABLE_STATS CMake
+ * option. Otherwise the hooks compile to nothing and every snapshot is zero; queryStatsEnabled()
+ * tells which build is in use.
+ *
+ * Counters are process-wide relaxed atomics, so recording from many threads is safe but not free:
+ * each recorded call costs two clock reads and a few atomic increments on counters shared by
+ * every thread. Calls the library makes internally, such as the holiday lookups of an adjustment,
+ * are recorded like any other. StaticCalendar is evaluated at compile time and is not
+ * instrumented.
+ *
+ * Example:
+ * @code
+ *   auto stats = getQueryStats();
+ *   for (std::size_t i = 0; i < STATS_OPERATION_COUNT; ++i) {
+ *       auto operation = static_cast<StatsOperation>(i);
+ *       export_histogram(statsOperationName(operation), stats.latency(operation));
+ *   }
+ *   resetQueryStats();
+ * @endcode
+ */
+struct QueryStats {
+    // Latency in nanoseconds of each call, by StatsOperation
+    std::array<Histogram, STATS_OPERATION_COUNT> latencies{};
+
+    // Evaluations of a rule for a year, by HolidayCalendar; the dates of a year are evaluated
+    // once and cached, so compare with year_bitmaps_built rather than with isHoliday() calls
+    std::uint64_t rule_evaluations = 0;
+
+    // Years whose holidays a HolidayCalendar computed, on a query missing its cache
+    std::uint64_t year_bitmaps_built = 0;
+
+    // Days examined by each business day adjustment (also by the column adjust() functions and
+    // ScheduleGenerator): 1 for a business day, otherwise the days each search visits, the
+    // starting day included. A search gives up after 367 days, MAX_DAYS_TO_SEARCH past the start
+    Histogram search_days;
+
+    // Adjustments that found no business day within the search limit
+    std::uint64_t search_limit_exceeded = 0;
+
+    /**
+     * @brief Get the latencies of an operation
+     */
+    [[nodiscard]] const Histogram& latency(StatsOperation operation) const noexcept {
+        return latencies[static_cast<std::size_t>(operation)];
+    }
+
+    friend bool operator==(const QueryStats&, const QueryStats&) = default;
+};
+
+/**
+ * @brief Check whether the library was built to record statistics
+ */
+[[nodiscard]] bool queryStatsEnabled() noexcept;
+
+/**
+ * @brief Get a snapshot of the statistics recorded since the last reset
+ *
+ * Each counter is read atomically, but the snapshot as a whole is not: calls completing while it
+ * is taken may be partly included.
+ */
+[[nodiscard]] QueryStats getQueryStats() noexcept;
+
+/**
+ * @brief Set every statistic back to zero
+ */
+void resetQueryStats() noexcept;
+
+} // namespace datelib
@@ -0,0 +1,353 @@
+#pragma once
+
+#include "datelib/detail/civil.h"
+#include "datelib/detail/easter.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace datelib {
+
+namespace detail {
+// Month, day and weekday validation constants
+inline constexpr unsigned MIN_MONTH = 1;
+inline constexpr unsigned MAX_MONTH = 12;
+inline constexpr unsigned MIN_DAY = 1;
+inline constexpr unsigned MAX_DAY = 31;
+inline constexpr unsigned MAX_WEEKDAY = 6;
+inline constexpr unsigned DAYS_PER_WEEK = 7;
+inline constexpr int MAX_EASTER_OFFSET = 366;
+inline constexpr int MAX_OBSERVANCE_SHIFT = 6;
+} // namespace detail
+
+/**
+ * @brief Enum for specifying occurrence of a weekday in a month
+ */
+enum class Occurrence { First = 1, Second = 2, Third = 3, Fourth = 4, Fifth = 5, Last = -1 };
+
+/**
+ * @brief Enum for specifying which Easter a holiday is relative to
+ */
+enum class EasterType {
+    /**
+     * @brief Easter of the Western churches, computed in the Gregorian calendar
+     */
+    Western,
+
+    /**
+     * @brief Easter of the Orthodox churches, computed in the Julian calendar
+     */
+    Orthodox
+};
+
+/**
+ * @brief Date calculation of a holiday on a fixed month and day each year
+ *
+ * This is the nameless, constexpr core of FixedDateRule. It is a literal type, so it can be used
+ * to build a StaticCalendar in a constant expression.
+ */
+class FixedDate {
+  public:
+    /**
+     * @brief Construct a fixed date
+     * @param month The month (1-12)
+     * @param day The day of month (1-31)
+     * @throws std::invalid_argument if the month or day is out of range
+     */
+    constexpr FixedDate(unsigned month, unsigned day) : month_{month}, day_{day} {
+        if (month < detail::MIN_MONTH || month > detail::MAX_MONTH) {
+            throw std::invalid_argument("Month must be between 1 and 12");
+        }
+        if (day < detail::MIN_DAY || day > detail::MAX_DAY) {
+            throw std::invalid_argument("Day must be between 1 and 31");
+        }
+    }
+
+    /**
+     * @brief Calculate the date in a given year
+     * @return The date, or std::nullopt if it does not exist in that year (February 29th in a
+     * common year, or a day beyond the end of the month)
+     */
+    [[nodiscard]] constexpr std::optional<std::chrono::year_month_day>
+    tryCalculate(int year) const noexcept {
+        std::chrono::year_month_day date{std::chrono::year{year}, month_, day_};
+        if (!date.ok()) {
+            return std::nullopt;
+        }
+        return date;
+    }
+
+  private:
+    std::chrono::month month_;
+    std::chrono::day day_;
+};
+
+/**
+ * @brief Date calculation of a holiday on the Nth occurrence of a weekday in a month
+ *
+ * This is the nameless, constexpr core of NthWeekdayRule, usable to build a StaticCalendar in a
+ * constant expression.
+ */
+class NthWeekday {
+  public:
+    /**
+     * @brief Construct an Nth weekday date
+     * @param month The month (1-12)
+     * @param weekday The day of week (0=Sunday, 6=Saturday)
+     * @param occurrence Which occurrence (First, Second, Third, Fourth, Fifth, or Last)
+     * @throws std::invalid_argument if any argument is out of range
+     */
+    constexpr NthWeekday(unsigned month, unsigned weekday, Occurrence occurrence)
+        : month_{month}, weekday_{weekday}, occurrence_(occurrence) {
+        if (month < detail::MIN_MONTH || month > detail::MAX_MONTH) {
+            throw std::invalid_argument("Month must be between 1 and 12");
+        }
+        if (weekday > detail::MAX_WEEKDAY) {
+            throw std::invalid_argument("Weekday must be between 0 and 6");
+        }
+        int occ_val = std::to_underlying(occurrence);
+        if (occ_val == 0 || occ_val < -1 || occ_val > 5) {
+            throw std::invalid_argument("Occurrence must be First through Fifth or Last");
+        }
+    }
+
+    /**
+     * @brief Calculate the date in a given year
+     * @return The date, or std::nullopt if the month has no such occurrence (a fifth weekday)
+     */
+    [[nodiscard]] constexpr std::optional<std::chrono::year_month_day>
+    tryCalculate(int year) const noexcept {
+        using detail::DAYS_PER_WEEK;
+
+        // Work on days of the month: only the weekday of the first needs a day number
+        const unsigned first_weekday =
+            detail::weekdayFromDays(detail::daysFromCivil(year, static_cast<unsigned>(month_), 1));
+        const auto days_in_month = static_cast<unsigned>(
+            std::chrono::year_month_day_last{std::chrono::year{year},
+                                             std::chrono::month_day_last{month_}}
+                .day());
+
+        int occ_val = std::to_underlying(occurrence_);
+        if (occ_val > 0) {
+            // Find the Nth occurrence of the target weekday
+            // Calculate days to add to reach first occurrence of target weekday
+            unsigned days_until_target =
+                (weekday_.c_encoding() + DAYS_PER_WEEK - first_weekday) % DAYS_PER_WEEK;
+
+            // Add weeks to get to the Nth occurrence
+            unsigned day_of_month =
+                1 + days_until_target + static_cast<unsigned>(occ_val - 1) * DAYS_PER_WEEK;
+
+            // A fifth occurrence may spill into the next month
+            if (day_of_month > days_in_month) {
+                return std::nullopt;
+            }
+
+            return std::chrono::year_month_day{std::chrono::year{year}, month_,
+                                               std::chrono::day{day_of_month}};
+        }
+
+        // Last occurrence, which always exists
+        unsigned last_weekday = (first_weekday + days_in_month - 1) % DAYS_PER_WEEK;
+
+        // Calculate days to subtract to get to last occurrence of target weekday
+        unsigned days_to_subtract =
+            (last_weekday + DAYS_PER_WEEK - weekday_.c_encoding()) % DAYS_PER_WEEK;
+
+        return std::chrono::year_month_day{std::chrono::year{year}, month_,
+                                           std::chrono::day{days_in_month - days_to_subtract}};
+    }
+
+  private:
+    std::chrono::month month_;
+    std::chrono::weekday weekday_;
+    Occurrence occurrence_;
+};
+
+/**
+ * @brief Date calculation of a one-time holiday on a specific date
+ *
+ * This is the nameless, constexpr core of ExplicitDateRule, usable to build a StaticCalendar in a
+ * constant expression.
+ */
+class ExplicitDate {
+  public:
+    /**
+     * @brief Construct an explicit date
+     * @param date The specific date (including year, month, and day)
+     * @throws std::invalid_argument if the date is invalid
+     */
+    constexpr explicit ExplicitDate(std::chrono::year_month_day date) : date_(date) {
+        if (!date_.ok()) {
+            throw std::invalid_argument("Invalid date");
+        }
+    }
+
+    /**
+     * @brief Calculate the date in a given year
+     * @return The stored date if the year matches, std::nullopt otherwise
+     */
+    [[nodiscard]] constexpr std::optional<std::chrono::year_month_day>
+    tryCalculate(int year) const noexcept {
+        if (static_cast<int>(date_.year()) == year) {
+            return date_;
+        }
+        return std::nullopt;
+    }
+
+  private:
+    std::chrono::year_month_day date_;
+};
+
+/**
+ * @brief Date calculation of a holiday a fixed number of days from Easter Sunday
+ *
+ * This is the nameless, constexpr core of EasterOffsetRule, usable to build a StaticCalendar in a
+ * constant expression. Easter is read from a table covering the years 1583 to 4099; the holiday
+ * does not exist in other years.
+ */
+class EasterOffset {
+  public:
+    /**
+     * @brief Construct an Easter-relative date
+     * @param offset_days Days from Easter Sunday (e.g. -2 for Good Friday, 1 for Easter Monday)
+     * @param type Which Easter the offset is relative to
+     * @throws std::invalid_argument if the offset or the type is out of range
+     */
+    constexpr explicit EasterOffset(int offset_days, EasterType type = EasterType::Western)
+        : offset_days_(offset_days), type_(type) {
+        if (offset_days < -detail::MAX_EASTER_OFFSET || offset_days > detail::MAX_EASTER_OFFSET) {
+            throw std::invalid_argument("Easter offset must be between -366 and 366 days");
+        }
+        if (type != EasterType::Western && type != EasterType::Orthodox) {
+            throw std::invalid_argument("Easter type must be Western or Orthodox");
+        }
+    }
+
+    /**
+     * @brief Calculate the date in a given year
+     * @return The date, or std::nullopt if the year is outside the Easter tables or the offset
+     * moves the date into another year
+     */
+    [[nodiscard]] constexpr std::optional<std::chrono::year_month_day>
+    tryCalculate(int year) const noexcept {
+        if (year < detail::EASTER_FIRST_YEAR || year > detail::EASTER_LAST_YEAR) {
+            return std::nullopt;
+        }
+
+        const auto& table = type_ == EasterType::Western ? detail::WESTERN_EASTER_TABLE
+                                                         : detail::ORTHODOX_EASTER_TABLE;
+        const auto easter = table[static_cast<std::size_t>(year - detail::EASTER_FIRST_YEAR)];
+        const auto days = detail::daysFromCivil(year, 3, 21) + easter + offset_days_;
+
+        auto date = detail::civilFromDays(days);
+        if (date.year != year) {
+            return std::nullopt;
+        }
+        return std::chrono::year_month_day{std::chrono::year{date.year},
+                                           std::chrono::month{date.month},
+                                           std::chrono::day{date.day}};
+    }
+
+  private:
+    int offset_days_;
+    EasterType type_;
+};
+
+/**
+ * @brief Days by which a holiday is moved when it falls on each weekday
+ *
+ * An observance maps every weekday to a shift of up to six days either way; the default
+ * observance moves nothing. It is a literal type, so observances can be built in constant
+ * expressions. A shifted date may leave the year of the original date: New Year's Day on a
+ * Saturday is observed on Friday, December 31st of the previous year.
+ *
+ * Example usage:
+ * @code
+ *   // Sunday holidays move to Monday, Saturday holidays stay where they are
+ *   constexpr auto observance = Observance{}.with(std::chrono::Sunday, 1);
+ * @endcode
+ */
+class Observance {
+  public:
+    /**
+     * @brief Construct an observance that moves no holiday
+     */
+    constexpr Observance() noexcept = default;
+
+    /**
+     * @brief Get a copy of this observance with the shift for one weekday replaced
+     * @param wd The weekday
+     * @param days Days to move a holiday falling on wd (negative moves it earlier)
+     * @throws std::invalid_argument if the weekday is invalid or the shift exceeds six days
+     */
+    [[nodiscard]] constexpr Observance with(std::chrono::weekday wd, int days) const {
+        if (!wd.ok()) {
+            throw std::invalid_argument("Weekday must be between 0 and 6");
+        }
+        if (days < -detail::MAX_OBSERVANCE_SHIFT || days > detail::MAX_OBSERVANCE_SHIFT) {
+            throw std::invalid_argument("Observance shift must be between -6 and 6 days");
+        }
+        Observance observance = *this;
+        observance.shifts_[wd.c_encoding()] = static_cast<std::int8_t>(days);
+        return observance;
+    }
+
+    /**
+     * @brief Get the shift for a weekday
+     * @param wd The weekday; invalid weekdays are not shifted
+     */
+    [[nodiscard]] constexpr int shiftFor(std::chrono::weekday wd) const noexcept {
+        return wd.ok() ? shifts_[wd.c_encoding()] : 0;
+    }
+
+    /**
+     * @brief Get the date a holiday on a given date is observed on
+     * @param date A valid date
+     */
+    [[nodiscard]] constexpr std::chrono::year_month_day
+    apply(const std::chrono::year_month_day& date) const noexcept {
+        const auto days = detail::daysFromCivil(static_cast<int>(date.year()),
+                                                static_cast<unsigned>(date.month()),
+                                                static_cast<unsigned>(date.day()));
+        const auto shift = shifts_[detail::weekdayFromDays(days)];
+        if (shift == 0) {
+            return date;
+        }
+        auto civil = detail::civilFromDays(days + shift);
+        return std::chrono::year_month_day{std::chrono::year{civil.year},
+                                           std::chrono::month{civil.month},
+                                           std::chrono::day{civil.day}};
+    }
+
+    friend constexpr bool operator==(const Observance&, const Observance&) = default;
+
+  private:
+    std::array<std::int8_t, detail::DAYS_PER_WEEK> shifts_{};
+};
+
+/**
+ * @brief Saturday holidays observed on the preceding Friday, Sunday holidays on the following
+ * Monday (the United States federal convention)
+ */
+inline constexpr Observance NEAREST_WEEKDAY_OBSERVANCE =
+    Observance{}.with(std::chrono::Saturday, -1).with(std::chrono::Sunday, 1);
+
+/**
+ * @brief Saturday and Sunday holidays both observed on the following Monday (the United Kingdom
+ * bank holiday convention for a single holiday)
+ */
+inline constexpr Observance NEXT_MONDAY_OBSERVANCE =
+    Observance{}.with(std::chrono::Saturday, 2).with(std::chrono::Sunday, 1);
+
+/**
+ * @brief Sunday holidays observed on the following Monday; Saturday holidays are not moved
+ */
+inline constexpr Observance SUNDAY_TO_MONDAY_OBSERVANCE = Observance{}.with(std::chrono::Sunday, 1);
+
+} // namespace datelib
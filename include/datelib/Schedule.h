@@ -0,0 +1,197 @@
+#pragma once
+
+#include "datelib/HolidayCalendar.h"
+#include "datelib/WeekendMask.h"
+#include "datelib/date.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace datelib {
+
+/**
+ * @brief Where the irregular period of a schedule goes when the tenor does not divide it evenly
+ */
+enum class StubRule {
+    /**
+     * @brief Roll backward from the end date; the first period is shorter than the tenor
+     */
+    ShortFront,
+
+    /**
+     * @brief Roll backward from the end date; the first period is longer than the tenor
+     */
+    LongFront,
+
+    /**
+     * @brief Roll forward from the start date; the last period is shorter than the tenor
+     */
+    ShortBack,
+
+    /**
+     * @brief Roll forward from the start date; the last period is longer than the tenor
+     */
+    LongBack
+};
+
+/**
+ * @brief Terms of one schedule of periodic dates
+ */
+struct ScheduleSpec {
+    /**
+     * @brief First date of the schedule (effective date)
+     */
+    std::chrono::year_month_day start;
+
+    /**
+     * @brief Last date of the schedule (termination date); must be after start
+     */
+    std::chrono::year_month_day end;
+
+    /**
+     * @brief Length of a regular period; must be positive
+     */
+    std::chrono::months tenor{3};
+
+    /**
+     * @brief Which end of the schedule carries the irregular period, and its length
+     */
+    StubRule stub = StubRule::ShortFront;
+
+    /**
+     * @brief Convention used to adjust every date of the schedule
+     */
+    BusinessDayConvention convention = BusinessDayConvention::ModifiedFollowing;
+
+    /**
+     * @brief Roll regular dates to month ends when the date rolled from is a month end
+     */
+    bool end_of_month = false;
+};
+
+/**
+ * @brief Generator of periodic payment schedules on a holiday calendar
+ *
+ * A schedule lists the start date, the regular dates rolled from one end by whole tenors, and the
+ * end date, each unadjusted and adjusted by the schedule's business day convention. Regular dates
+ * are rolled from the anchor (the end date for front stubs, the start date for back stubs) rather
+ * than from each other, so a day of month that does not exist in a shorter month is clamped in
+ * that month alone. With end_of_month set and a month-end anchor, every regular date is a month
+ * end.
+ *
+ * The generator lays out the business days of its horizon as one bitmap indexed by day number
+ * when it is built, and never modifies it afterwards. Adjusting a date is then a bit test without
+ * locking, so any number of threads can share a generator; the batch overload of generate() does
+ * exactly that. Dates outside the horizon are looked up in the calendar, which is correct but
+ * slower.
+ *
+ * The number of dates of a schedule is known from its terms alone (size()), so output buffers can
+ * be allocated once, up front, for a whole portfolio (offsets()).
+ *
+ * Example usage:
+ * @code
+ *   ScheduleGenerator generator(calendar, 2020, 2060);
+ *
+ *   auto offsets = ScheduleGenerator::offsets(specs);
+ *   std::vector<sys_days> unadjusted(offsets.back());
+ *   std::vector<sys_days> adjusted(offsets.back());
+ *   generator.generate(specs, offsets, unadjusted, adjusted);
+ *
+ *   // Schedule i is [offsets[i], offsets[i + 1]) of both buffers
+ * @endcode
+ */
+class ScheduleGenerator {
+  public:
+    /**
+     * @brief Build a generator over a range of years
+     * @param calendar The holiday calendar to adjust dates with
+     * @param first_year The first year of the horizon
+     * @param last_year The last year of the horizon (inclusive)
+     * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+     * @throws std::invalid_argument if last_year is before first_year
+     */
+    ScheduleGenerator(const HolidayCalendar& calendar, int first_year, int last_year,
+                      WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+    /**
+     * @brief Get the first year of the horizon
+     */
+    [[nodiscard]] int firstYear() const noexcept { return first_year_; }
+
+    /**
+     * @brief Get the last year of the horizon (inclusive)
+     */
+    [[nodiscard]] int lastYear() const noexcept { return last_year_; }
+
+    /**
+     * @brief Get the number of dates of a schedule, start and end included
+     * @param spec The terms of the schedule
+     * @throws std::invalid_argument if the terms are invalid
+     *
+     * This is computed from the terms in constant time, without generating the dates.
+     */
+    [[nodiscard]] static std::size_t size(const ScheduleSpec& spec);
+
+    /**
+     * @brief Get the positions of a portfolio of schedules in shared output buffers
+     * @param specs The terms of each schedule
+     * @return specs.size() + 1 offsets: schedule i occupies [offsets[i], offsets[i + 1]), and the
+     * last offset is the total number of dates
+     * @throws std::invalid_argument if the terms of any schedule are invalid
+     */
+    [[nodiscard]] static std::vector<std::size_t> offsets(std::span<const ScheduleSpec> specs);
+
+    /**
+     * @brief Generate one schedule
+     * @param spec The terms of the schedule
+     * @param unadjusted Receives the unadjusted dates in ascending order
+     * @param adjusted Receives the adjusted dates, in the same order
+     * @return The number of dates written, which is size(spec)
+     * @throws std::invalid_argument if the terms are invalid or a buffer is smaller than
+     * size(spec)
+     * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+     */
+    std::size_t generate(const ScheduleSpec& spec, std::span<std::chrono::sys_days> unadjusted,
+                         std::span<std::chrono::sys_days> adjusted) const;
+
+    /**
+     * @brief Generate a portfolio of schedules in parallel
+     * @param specs The terms of each schedule
+     * @param offsets The positions of the schedules in the buffers, as returned by offsets()
+     * @param unadjusted Receives the unadjusted dates of every schedule
+     * @param adjusted Receives the adjusted dates of every schedule
+     * @param threads The number of threads to use; 0 uses one per hardware thread
+     * @throws std::invalid_argument if the offsets do not match the schedules or the buffers
+     * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+     *
+     * The schedules are handed out to the threads in chunks from a shared counter, so threads that
+     * draw short schedules take more chunks and all finish together. Threads share nothing but the
+     * counter: each writes its schedules' own slices of the buffers. If a schedule fails, the
+     * remaining chunks are abandoned and the first exception is rethrown once every thread has
+     * stopped; the contents of the buffers are then unspecified.
+     */
+    void generate(std::span<const ScheduleSpec> specs, std::span<const std::size_t> offsets,
+                  std::span<std::chrono::sys_days> unadjusted,
+                  std::span<std::chrono::sys_days> adjusted, unsigned threads = 0) const;
+
+  private:
+    /**
+     * @brief Check whether a day is a business day
+     */
+    [[nodiscard]] bool isBusinessDay(std::chrono::sys_days day) const;
+
+    HolidayCalendar calendar_;
+    WeekendMask weekend_;
+    int first_year_;
+    int last_year_;
+    std::chrono::sys_days first_day_;
+    std::chrono::sys_days end_day_;
+
+    // Bit i is set when first_day_ + i days is a business day
+    std::vector<std::uint64_t> business_days_;
+};
+
+} // namespace datelib
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "datelib/RuleDates.h"
+#include "datelib/WeekendMask.h"
+#include "datelib/YearBitmap.h"
+#include "datelib/date.h"
+#include "datelib/detail/adjust.h"
+#include "datelib/detail/civil.h"
+#include "datelib/exceptions.h"
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+
+namespace datelib {
+
+/**
+ * @brief A holiday date calculation usable to build a StaticCalendar
+ *
+ * FixedDate, NthWeekday, ExplicitDate and EasterOffset model it; their tryCalculate() is
+ * constexpr, so a calendar built from them can be evaluated at compile time.
+ */
+template <typename T>
+concept HolidayDate = requires(const T& date, int year) {
+    { date.tryCalculate(year) } -> std::same_as<std::optional<std::chrono::year_month_day>>;
+};
+
+/**
+ * @brief Holiday calendar over a fixed range of years, computable at compile time
+ *
+ * A StaticCalendar holds one holiday bitmap per year from FirstYear to LastYear, in a plain array
+ * inside the object. It is built from FixedDate, NthWeekday, ExplicitDate and EasterOffset values,
+ * which are literal types, so a calendar declared constexpr has its bitmaps computed by the
+ * compiler and placed in read-only data: there is no startup cost, no heap allocation and no
+ * locking. Holidays have no names; use HolidayCalendar or CompiledCalendar when names are needed.
+ *
+ * Like CompiledCalendar, queries about years outside the range throw YearOutOfRangeException.
+ *
+ * Example usage:
+ * @code
+ *   constexpr StaticCalendar<2000, 2100> us_calendar{
+ *       FixedDate{1, 1}, FixedDate{7, 4}, FixedDate{12, 25},
+ *       NthWeekday{11, 4, Occurrence::Fourth}};
+ *
+ *   static_assert(!isBusinessDay(year_month_day{year{2024}, month{12}, day{25}}, us_calendar));
+ *   auto settlement = adjust(date, BusinessDayConvention::Following, us_calendar);
+ * @endcode
+ */
+template <int FirstYear, int LastYear>
+class StaticCalendar {
+    static_assert(FirstYear <= LastYear, "Last year must not be before first year");
+
+  public:
+    /**
+     * @brief First year of the range
+     */
+    static constexpr int FIRST_YEAR = FirstYear;
+
+    /**
+     * @brief Last year of the range (inclusive)
+     */
+    static constexpr int LAST_YEAR = LastYear;
+
+    /**
+     * @brief Construct a calendar from holiday date calculations
+     * @param dates The holidays; each is evaluated for every year of the range
+     */
+    template <HolidayDate... Dates>
+    constexpr explicit StaticCalendar(const Dates&... dates) noexcept {
+        for (int year = FirstYear; year <= LastYear; ++year) {
+            auto& bitmap = bitmaps_[static_cast<std::size_t>(year - FirstYear)];
+            (add(bitmap, dates.tryCalculate(year), year), ...);
+        }
+    }
+
+    /**
+     * @brief Get the first year of the range
+     */
+    [[nodiscard]] constexpr int firstYear() const noexcept { return FirstYear; }
+
+    /**
+     * @brief Get the last year of the range (inclusive)
+     */
+    [[nodiscard]] constexpr int lastYear() const noexcept { return LastYear; }
+
+    /**
+     * @brief Check whether a date lies within the range
+     * @param date The date to check
+     */
+    [[nodiscard]] constexpr bool contains(const std::chrono::year_month_day& date) const noexcept {
+        if (!date.ok()) {
+            return false;
+        }
+        auto year = static_cast<int>(date.year());
+        return year >= FirstYear && year <= LastYear;
+    }
+
+    /**
+     * @brief Check if a given date is a holiday
+     * @param date The date to check
+     * @return true if the date is a holiday, false otherwise (including for invalid dates)
+     * @throws YearOutOfRangeException if a valid date lies outside the range
+     */
+    [[nodiscard]] constexpr bool isHoliday(const std::chrono::year_month_day& date) const {
+        if (!date.ok()) {
+            return false;
+        }
+        return getHolidayBitmap(static_cast<int>(date.year())).test(YearBitmap::indexOf(date));
+    }
+
+    /**
+     * @brief Get the holidays of a year as a bitmap
+     * @param year The year to get holidays for
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] constexpr const YearBitmap& getHolidayBitmap(int year) const {
+        if (year < FirstYear || year > LastYear) {
+            throw YearOutOfRangeException("Year is outside the range of the static calendar");
+        }
+        return bitmaps_[static_cast<std::size_t>(year - FirstYear)];
+    }
+
+    /**
+     * @brief Get the business days of a year as a bitmap
+     * @param year The year to get business days for
+     * @param weekend The weekdays considered as weekend
+     * @return A bitmap with the bit set for every day of the year that is neither a weekend day
+     * nor a holiday
+     * @throws YearOutOfRangeException if the year lies outside the range
+     */
+    [[nodiscard]] constexpr YearBitmap getBusinessDayBitmap(int year, WeekendMask weekend) const {
+        return YearBitmap::allDays(year) & ~(getHolidayBitmap(year) | weekend.daysIn(year));
+    }
+
+  private:
+    /**
+     * @brief Mark a calculated date, which may belong to another year (an ExplicitDate does not)
+     */
+    static constexpr void add(YearBitmap& bitmap,
+                              const std::optional<std::chrono::year_month_day>& date,
+                              int year) noexcept {
+        if (date && date->ok() && static_cast<int>(date->year()) == year) {
+            bitmap.set(YearBitmap::indexOf(*date));
+        }
+    }
+
+    // One holiday bitmap per year of the range
+    std::array<YearBitmap, static_cast<std::size_t>(LastYear - FirstYear) + 1> bitmaps_{};
+};
+
+/**
+ * @brief Check if a given date is a business day in a static calendar
+ * @param date The date to check
+ * @param calendar The static calendar to use for checking holidays
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return true if the date is not a weekend day and not a holiday, false otherwise
+ * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+ * @throws YearOutOfRangeException if the date lies outside the years of the static calendar
+ */
+template <int FirstYear, int LastYear>
+[[nodiscard]] constexpr bool isBusinessDay(const std::chrono::year_month_day& date,
+                                           const StaticCalendar<FirstYear, LastYear>& calendar,
+                                           WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND) {
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to isBusinessDay");
+    }
+
+    return !weekend.contains(detail::weekdayOf(detail::toSysDays(date))) &&
+           !calendar.isHoliday(date);
+}
+
+/**
+ * @brief Adjust a date according to a business day convention using a static calendar
+ * @param date The date to adjust
+ * @param convention The business day convention to apply
+ * @param calendar The static calendar to use for checking holidays
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return The adjusted date according to the specified convention
+ * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+ * @throws YearOutOfRangeException if the adjustment visits a year outside the static calendar
+ * @throws BusinessDaySearchException if no business day is found within a year
+ */
+template <int FirstYear, int LastYear>
+[[nodiscard]] constexpr std::chrono::year_month_day
+adjust(const std::chrono::year_month_day& date, BusinessDayConvention convention,
+       const StaticCalendar<FirstYear, LastYear>& calendar,
+       WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND) {
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to adjust");
+    }
+
+    auto is_business_day = [&](std::chrono::sys_days day) {
+        return !weekend.contains(detail::weekdayOf(day)) &&
+               !calendar.isHoliday(detail::toYearMonthDay(day));
+    };
+    return detail::toYearMonthDay(
+        detail::adjustDay(detail::toSysDays(date), convention, is_business_day));
+}
+
+} // namespace datelib
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "datelib/YearBitmap.h"
+#include "datelib/date_util.h"
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
+
+namespace datelib {
+
+/**
+ * @brief Set of weekdays treated as weekend days, stored as a 7-bit mask
+ *
+ * Bit i is set when the weekday whose C encoding is i (0 = Sunday, 6 = Saturday) is a weekend
+ * day. Unlike std::unordered_set, the mask is trivially copyable, never allocates and can be built
+ * in constant expressions.
+ *
+ * Example usage:
+ * @code
+ *   constexpr auto weekend = WeekendMask{}.with(std::chrono::Friday).with(std::chrono::Saturday);
+ *   isBusinessDay(date, calendar, weekend);
+ * @endcode
+ */
+class WeekendMask {
+  public:
+    /**
+     * @brief Bits that may be set in a mask (one per weekday)
+     */
+    static constexpr std::uint8_t ALL_DAYS = 0x7F;
+
+    /**
+     * @brief Construct an empty mask (a seven-day work week)
+     */
+    constexpr WeekendMask() noexcept = default;
+
+    /**
+     * @brief Convert a set of weekend days into a mask
+     * @param weekend_days The weekdays considered as weekend
+     */
+    explicit WeekendMask(
+        const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days) noexcept {
+        for (const auto& wd : weekend_days) {
+            *this = with(wd);
+        }
+    }
+
+    /**
+     * @brief Build a mask from its raw bits
+     * @param bits Bit i marks the weekday with C encoding i; bits above the seventh are ignored
+     */
+    [[nodiscard]] static constexpr WeekendMask fromBits(std::uint8_t bits) noexcept {
+        WeekendMask mask;
+        mask.bits_ = static_cast<std::uint8_t>(bits & ALL_DAYS);
+        return mask;
+    }
+
+    /**
+     * @brief Get a copy of this mask with one more weekend day
+     * @param wd The weekday to add; invalid weekdays are ignored
+     */
+    [[nodiscard]] constexpr WeekendMask with(std::chrono::weekday wd) const noexcept {
+        if (!wd.ok()) {
+            return *this;
+        }
+        return fromBits(static_cast<std::uint8_t>(bits_ | (1U << wd.c_encoding())));
+    }
+
+    /**
+     * @brief Check whether a weekday is a weekend day
+     * @param wd The weekday to check
+     */
+    [[nodiscard]] constexpr bool contains(std::chrono::weekday wd) const noexcept {
+        return wd.ok() && ((bits_ >> wd.c_encoding()) & 1U) != 0;
+    }
+
+    /**
+     * @brief Get the weekend days of a year as a bitmap
+     * @param year The year to describe
+     * @return A bitmap with the bit set for every weekend day of the year
+     */
+    [[nodiscard]] constexpr YearBitmap daysIn(int year) const noexcept {
+        YearBitmap bitmap;
+        auto length = YearBitmap::lengthOf(year);
+        std::chrono::weekday first{std::chrono::sys_days{std::chrono::year{year} /
+                                                         std::chrono::January / 1}};
+        for (unsigned wd = 0; wd < DAYS_PER_WEEK; ++wd) {
+            if (((bits_ >> wd) & 1U) == 0) {
+                continue;
+            }
+            auto index = (wd + DAYS_PER_WEEK - first.c_encoding()) % DAYS_PER_WEEK;
+            for (; index < length; index += DAYS_PER_WEEK) {
+                bitmap.set(index);
+            }
+        }
+        return bitmap;
+    }
+
+    /**
+     * @brief Check whether the mask has no weekend days
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept { return bits_ == 0; }
+
+    /**
+     * @brief Get the raw bits of the mask
+     */
+    [[nodiscard]] constexpr std::uint8_t bits() const noexcept { return bits_; }
+
+    friend constexpr bool operator==(WeekendMask, WeekendMask) = default;
+
+  private:
+    static constexpr unsigned DAYS_PER_WEEK = 7;
+
+    std::uint8_t bits_ = 0;
+};
+
+/**
+ * @brief Saturday and Sunday weekend (the default for business day functions)
+ */
+inline constexpr WeekendMask SATURDAY_SUNDAY_WEEKEND =
+    WeekendMask{}.with(std::chrono::Saturday).with(std::chrono::Sunday);
+
+/**
+ * @brief Friday and Saturday weekend, as used in parts of the Middle East
+ */
+inline constexpr WeekendMask FRIDAY_SATURDAY_WEEKEND =
+    WeekendMask{}.with(std::chrono::Friday).with(std::chrono::Saturday);
+
+/**
+ * @brief Sunday-only weekend (a six-day work week)
+ */
+inline constexpr WeekendMask SUNDAY_WEEKEND = WeekendMask{}.with(std::chrono::Sunday);
+
+} // namespace datelib
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "datelib/detail/civil.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace datelib {
+
+/**
+ * @brief Fixed-size bitset holding one bit per day of a calendar year
+ *
+ * Bit 0 corresponds to January 1st and bit 365 to December 31st of a leap year. In non-leap years
+ * the last bit is never set. The bitmap is trivially copyable and usable in constant expressions.
+ */
+class YearBitmap {
+  public:
+    /**
+     * @brief Number of days covered by the bitmap (the length of a leap year)
+     */
+    static constexpr std::size_t DAYS = 366;
+
+    /**
+     * @brief Number of bits stored per word
+     */
+    static constexpr std::size_t WORD_BITS = 64;
+
+    /**
+     * @brief Number of 64-bit words backing the bitmap
+     */
+    static constexpr std::size_t WORDS = (DAYS + WORD_BITS - 1) / WORD_BITS;
+
+    /**
+     * @brief Construct an empty bitmap
+     */
+    constexpr YearBitmap() noexcept = default;
+
+    /**
+     * @brief Build a bitmap with every day of a year set
+     * @param year The year the bitmap describes
+     */
+    [[nodiscard]] static constexpr YearBitmap allDays(int year) noexcept {
+        YearBitmap bitmap;
+        auto length = lengthOf(year);
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            auto first = w * WORD_BITS;
+            if (length >= first + WORD_BITS) {
+                bitmap.words_[w] = ~std::uint64_t{0};
+            } else if (length > first) {
+                bitmap.words_[w] = (std::uint64_t{1} << (length - first)) - 1;
+            }
+        }
+        return bitmap;
+    }
+
+    /**
+     * @brief Build a bitmap from its underlying words
+     * @param words Bit i of the bitmap is bit i % 64 of words[i / 64]
+     */
+    [[nodiscard]] static constexpr YearBitmap
+    fromWords(const std::array<std::uint64_t, WORDS>& words) noexcept {
+        YearBitmap bitmap;
+        bitmap.words_ = words;
+        return bitmap;
+    }
+
+    /**
+     * @brief Get the number of days in a year (365 or 366)
+     * @param year The year to measure
+     */
+    [[nodiscard]] static constexpr unsigned lengthOf(int year) noexcept {
+        return std::chrono::year{year}.is_leap() ? 366U : 365U;
+    }
+
+    /**
+     * @brief Get the bit index of a date within its year
+     * @param date A valid date
+     * @return Zero-based day of the year (0 for January 1st)
+     */
+    [[nodiscard]] static constexpr unsigned
+    indexOf(const std::chrono::year_month_day& date) noexcept {
+        auto year = static_cast<int>(date.year());
+        return static_cast<unsigned>(
+            detail::daysFromCivil(year, static_cast<unsigned>(date.month()),
+                                  static_cast<unsigned>(date.day())) -
+            detail::daysFromCivil(year, 1, 1));
+    }
+
+    /**
+     * @brief Get the date corresponding to a bit index
+     * @param year The year the bitmap describes
+     * @param index Zero-based day of the year
+     * @return The date of that day
+     */
+    [[nodiscard]] static constexpr std::chrono::year_month_day dateAt(int year,
+                                                                      unsigned index) noexcept {
+        auto civil = detail::civilFromDays(detail::daysFromCivil(year, 1, 1) +
+                                           static_cast<std::int32_t>(index));
+        return std::chrono::year_month_day{std::chrono::year{civil.year},
+                                           std::chrono::month{civil.month},
+                                           std::chrono::day{civil.day}};
+    }
+
+    /**
+     * @brief Check whether the bit for a day is set
+     * @param index Zero-based day of the year
+     */
+    [[nodiscard]] constexpr bool test(unsigned index) const noexcept {
+        return ((words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1U) != 0;
+    }
+
+    /**
+     * @brief Set the bit for a day
+     * @param index Zero-based day of the year
+     */
+    constexpr void set(unsigned index) noexcept {
+        words_[index / WORD_BITS] |= std::uint64_t{1} << (index % WORD_BITS);
+    }
+
+    /**
+     * @brief Count the number of set bits
+     */
+    [[nodiscard]] constexpr std::size_t count() const noexcept {
+        std::size_t total = 0;
+        for (auto word : words_) {
+            total += static_cast<std::size_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    /**
+     * @brief Check whether no bit is set
+     */
+    [[nodiscard]] constexpr bool none() const noexcept {
+        for (auto word : words_) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Count the set bits in a half-open range of days
+     * @param first Index of the first day to count
+     * @param last Index one past the last day to count (at most DAYS)
+     */
+    [[nodiscard]] constexpr std::size_t count(unsigned first, unsigned last) const noexcept {
+        std::size_t total = 0;
+        while (first < last) {
+            auto w = first / WORD_BITS;
+            auto offset = first % WORD_BITS;
+            auto span = std::min<std::size_t>(WORD_BITS - offset, last - first);
+            auto mask = span == WORD_BITS ? ~std::uint64_t{0} : (std::uint64_t{1} << span) - 1;
+            total += static_cast<std::size_t>(std::popcount((words_[w] >> offset) & mask));
+            first += static_cast<unsigned>(span);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Find the set bit with a given rank
+     * @param rank Zero-based rank among the set bits (0 selects the lowest set bit)
+     * @return Index of the selected bit, or DAYS if fewer than rank + 1 bits are set
+     */
+    [[nodiscard]] constexpr unsigned select(std::size_t rank) const noexcept {
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            auto word = words_[w];
+            auto bits = static_cast<std::size_t>(std::popcount(word));
+            if (rank >= bits) {
+                rank -= bits;
+                continue;
+            }
+            for (; rank > 0; --rank) {
+                word &= word - 1;
+            }
+            return static_cast<unsigned>(w * WORD_BITS + std::countr_zero(word));
+        }
+        return static_cast<unsigned>(DAYS);
+    }
+
+    /**
+     * @brief Invoke a function with the index of every set bit, in ascending order
+     * @param func Callable taking the zero-based day of the year
+     */
+    template <typename Func>
+    constexpr void forEach(Func&& func) const {
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            for (auto word = words_[w]; word != 0; word &= word - 1) {
+                func(static_cast<unsigned>(w * WORD_BITS + std::countr_zero(word)));
+            }
+        }
+    }
+
+    /**
+     * @brief Access the underlying words (bit i of the bitmap is bit i % 64 of word i / 64)
+     */
+    [[nodiscard]] constexpr const std::array<std::uint64_t, WORDS>& words() const noexcept {
+        return words_;
+    }
+
+    constexpr YearBitmap& operator|=(const YearBitmap& other) noexcept {
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            words_[w] |= other.words_[w];
+        }
+        return *this;
+    }
+
+    constexpr YearBitmap& operator&=(const YearBitmap& other) noexcept {
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            words_[w] &= other.words_[w];
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr YearBitmap operator|(YearBitmap lhs,
+                                                        const YearBitmap& rhs) noexcept {
+        return lhs |= rhs;
+    }
+
+    [[nodiscard]] friend constexpr YearBitmap operator&(YearBitmap lhs,
+                                                        const YearBitmap& rhs) noexcept {
+        return lhs &= rhs;
+    }
+
+    /**
+     * @brief Complement every bit, including the unused bit past the end of a non-leap year
+     *
+     * Combine with allDays() to stay within a year: allDays(year) & ~bitmap.
+     */
+    [[nodiscard]] constexpr YearBitmap operator~() const noexcept {
+        YearBitmap result;
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            result.words_[w] = ~words_[w];
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const YearBitmap&, const YearBitmap&) = default;
+
+  private:
+    std::array<std::uint64_t, WORDS> words_{};
+};
+
+} // namespace datelib
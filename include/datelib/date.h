@@ -1,15 +1,21 @@
 #pragma once
 
+#include "datelib/WeekendMask.h"
 #include "datelib/date_util.h"
 #include "datelib/exceptions.h"
 
 #include <chrono>
+#include <cstdint>
+#include <span>
 #include <unordered_set>
 
 namespace datelib {
 
-// Forward declaration
+// Forward declarations
+class CompiledCalendar;
 class HolidayCalendar;
+class JointCalendar;
+class MappedCalendar;
 
 /**
  * @brief Business day adjustment conventions for date rolling
@@ -47,21 +53,89 @@ enum class BusinessDayConvention {
  * @brief Check if a given date is a business day
  * @param date The date to check
  * @param calendar The holiday calendar to use for checking holidays
- * @param weekend_days The set of weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
  * @return true if the date is not a weekend day and not a holiday, false otherwise
  * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
  */
+[[nodiscard]] bool isBusinessDay(const std::chrono::year_month_day& date,
+                                 const HolidayCalendar& calendar,
+                                 WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Check if a given date is a business day
+ * @param date The date to check
+ * @param calendar The holiday calendar to use for checking holidays
+ * @param weekend_days The set of weekdays considered as weekend
+ * @return true if the date is not a weekend day and not a holiday, false otherwise
+ * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+ *
+ * The set is converted to a WeekendMask once; prefer the WeekendMask overload in hot loops.
+ */
 [[nodiscard]] bool
 isBusinessDay(const std::chrono::year_month_day& date, const HolidayCalendar& calendar,
-              const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days = {
-                  std::chrono::Saturday, std::chrono::Sunday});
+              const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days);
+
+/**
+ * @brief Check if a given date is a business day in a compiled calendar
+ * @param date The date to check
+ * @param calendar The compiled calendar to use for checking holidays
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return true if the date is not a weekend day and not a holiday, false otherwise
+ * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+ * @throws YearOutOfRangeException if the date lies outside the years of the compiled calendar
+ */
+[[nodiscard]] bool isBusinessDay(const std::chrono::year_month_day& date,
+                                 const CompiledCalendar& calendar,
+                                 WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Check if a given date is a business day in a memory-mapped calendar
+ * @param date The date to check
+ * @param calendar The mapped calendar to use for checking holidays
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return true if the date is not a weekend day and not a holiday, false otherwise
+ * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+ * @throws YearOutOfRangeException if the date lies outside the years of the mapped calendar
+ */
+[[nodiscard]] bool isBusinessDay(const std::chrono::year_month_day& date,
+                                 const MappedCalendar& calendar,
+                                 WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Check if a given date is a business day in a joint calendar
+ * @param date The date to check
+ * @param calendar The joint calendar, which carries the weekend of each of its calendars
+ * @return true if the date is a business day under the calendar's join rule, false otherwise
+ * @throws std::invalid_argument if the date is invalid (e.g., February 30th)
+ */
+[[nodiscard]] bool isBusinessDay(const std::chrono::year_month_day& date,
+                                 const JointCalendar& calendar);
+
+/**
+ * @brief Check a column of days for business days
+ * @param dates The days to check
+ * @param results Receives 1 for each business day and 0 otherwise; must have the same size as
+ * dates
+ * @param calendar The holiday calendar to use for checking holidays
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @throws std::invalid_argument if the spans differ in size
+ *
+ * Each element gets the same result as the scalar isBusinessDay(). The business days of every
+ * year spanned by the input are first laid out as one bitmap indexed by day number, with the
+ * weekend folded in; classifying a day is then a word fetch and a bit test. On x86-64 CPUs with
+ * AVX2 (detected at run time) the fetches are done eight days at a time with vector gathers;
+ * elsewhere a scalar loop is used. Inputs spanning a thousand years or more skip the bitmap and
+ * look up each day in the calendar's per-year bitmaps.
+ */
+void isBusinessDay(std::span<const std::chrono::sys_days> dates, std::span<std::uint8_t> results,
+                   const HolidayCalendar& calendar, WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
 
 /**
  * @brief Adjust a date according to a business day convention
  * @param date The date to adjust
  * @param convention The business day convention to apply
  * @param calendar The holiday calendar to use for checking business days
- * @param weekend_days The set of weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
  * @return The adjusted date according to the specified convention
  * @throws std::invalid_argument if the input date is invalid
  * @throws BusinessDaySearchException if unable to find a business day within reasonable range
@@ -76,9 +150,143 @@ isBusinessDay(const std::chrono::year_month_day& date, const HolidayCalendar& ca
  * - Unadjusted: Returns the date unchanged
  */
 [[nodiscard]] std::chrono::year_month_day
+adjust(const std::chrono::year_month_day& date, BusinessDayConvention convention,
+       const HolidayCalendar& calendar, WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Adjust a date according to a business day convention
+ * @param date The date to adjust
+ * @param convention The business day convention to apply
+ * @param calendar The holiday calendar to use for checking business days
+ * @param weekend_days The set of weekdays considered as weekend
+ * @return The adjusted date according to the specified convention
+ * @throws std::invalid_argument if the input date is invalid
+ * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+ *
+ * The set is converted to a WeekendMask once; prefer the WeekendMask overload in hot loops.
+ */
+[[nodiscard]] std::chrono::year_month_day
 adjust(const std::chrono::year_month_day& date, BusinessDayConvention convention,
        const HolidayCalendar& calendar,
-       const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days = {
-           std::chrono::Saturday, std::chrono::Sunday});
+       const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days);
+
+/**
+ * @brief Adjust a date according to a business day convention using a compiled calendar
+ * @param date The date to adjust
+ * @param convention The business day convention to apply
+ * @param calendar The compiled calendar to use for checking business days
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return The adjusted date according to the specified convention
+ * @throws std::invalid_argument if the input date is invalid
+ * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+ * @throws YearOutOfRangeException if the search leaves the years of the compiled calendar
+ *
+ * Same conventions as the HolidayCalendar overload.
+ */
+[[nodiscard]] std::chrono::year_month_day
+adjust(const std::chrono::year_month_day& date, BusinessDayConvention convention,
+       const CompiledCalendar& calendar, WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Adjust a date according to a business day convention using a memory-mapped calendar
+ * @param date The date to adjust
+ * @param convention The business day convention to apply
+ * @param calendar The mapped calendar to use for checking business days
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return The adjusted date according to the specified convention
+ * @throws std::invalid_argument if the input date is invalid
+ * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+ * @throws YearOutOfRangeException if the search leaves the years of the mapped calendar
+ *
+ * Same conventions as the HolidayCalendar overload.
+ */
+[[nodiscard]] std::chrono::year_month_day
+adjust(const std::chrono::year_month_day& date, BusinessDayConvention convention,
+       const MappedCalendar& calendar, WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Adjust a date according to a business day convention using a joint calendar
+ * @param date The date to adjust
+ * @param convention The business day convention to apply
+ * @param calendar The joint calendar, which carries the weekend of each of its calendars
+ * @return The adjusted date according to the specified convention
+ * @throws std::invalid_argument if the input date is invalid
+ * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+ *
+ * Same conventions as the HolidayCalendar overload. The walk tests bits of the joint business
+ * day bitmap, which is computed once per year visited.
+ */
+[[nodiscard]] std::chrono::year_month_day adjust(const std::chrono::year_month_day& date,
+                                                 BusinessDayConvention convention,
+                                                 const JointCalendar& calendar);
+
+/**
+ * @brief Adjust a column of dates according to a business day convention
+ * @param dates The dates to adjust
+ * @param adjusted Receives the adjusted dates; must have the same size as dates and may be the
+ * same buffer
+ * @param convention The business day convention to apply
+ * @param calendar The holiday calendar to use for checking business days
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @throws std::invalid_argument if the spans differ in size or an input date is invalid
+ * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+ *
+ * Each element gets the same result as the scalar adjust(). The column is processed as a stream:
+ * the business days of the year being visited are held as a bitmap, so consecutive dates in the
+ * same year are bit tests and the calendar is consulted once per year crossed. Sorted input
+ * (cash flow schedules, blotters ordered by date) is therefore the fast path, and repeated dates
+ * reuse the previous result.
+ */
+void adjust(std::span<const std::chrono::year_month_day> dates,
+            std::span<std::chrono::year_month_day> adjusted, BusinessDayConvention convention,
+            const HolidayCalendar& calendar, WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Adjust a column of day counts according to a business day convention
+ * @param dates The days to adjust
+ * @param adjusted Receives the adjusted days; must have the same size as dates and may be the
+ * same buffer
+ * @param convention The business day convention to apply
+ * @param calendar The holiday calendar to use for checking business days
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @throws std::invalid_argument if the spans differ in size
+ * @throws BusinessDaySearchException if unable to find a business day within reasonable range
+ *
+ * Same as the year_month_day overload, without converting to and from civil dates.
+ */
+void adjust(std::span<const std::chrono::sys_days> dates, std::span<std::chrono::sys_days> adjusted,
+            BusinessDayConvention convention, const HolidayCalendar& calendar,
+            WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
+
+/**
+ * @brief Move a date by a number of business days
+ * @param date The date to start from
+ * @param n The number of business days to move; negative values move backward
+ * @param calendar The holiday calendar to use for checking business days
+ * @param weekend The weekdays considered as weekend (defaults to Saturday and Sunday)
+ * @return For positive n, the nth business day after date; for negative n, the |n|th business
+ * day before date; for zero, date itself if it is a business day and the following business day
+ * otherwise
+ * @throws std::invalid_argument if the input date is invalid
+ * @throws BusinessDaySearchException if a whole year without business days is crossed, or if
+ * the target lies outside the years of std::chrono::year (before year::min() or after
+ * year::max())
+ *
+ * This computes T+n settlement and payment dates. Rather than stepping one day at a time, it
+ * skips whole years by counting the bits of the calendar's per-year business day bitmaps and
+ * then selects the target by rank within its year. The cost is O(|n| / 250 + 1): one cached
+ * bitmap lookup and popcount per year crossed, plus one select. It still grows with n, so it is
+ * not the constant-time jump of BusinessDayIndex::addBusinessDays(), which answers any offset
+ * within its horizon by one rank lookup; build an index for repeated offsets over a fixed range
+ * of years.
+ *
+ * Example usage:
+ * @code
+ *   auto settlement = addBusinessDays(trade_date, 2, calendar); // T+2
+ * @endcode
+ */
+[[nodiscard]] std::chrono::year_month_day
+addBusinessDays(const std::chrono::year_month_day& date, int n, const HolidayCalendar& calendar,
+                WeekendMask weekend = SATURDAY_SUNDAY_WEEKEND);
 
 } // namespace datelib
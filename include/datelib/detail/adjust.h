@@ -0,0 +1,123 @@
+#pragma once
+
+#include "datelib/date.h"
+#include "datelib/detail/civil.h"
+#include "datelib/exceptions.h"
+
+#include <chrono>
+
+/**
+ * @file adjust.h
+ * @brief Internal business day walks shared by every calendar type
+ *
+ * The walks take a predicate telling whether a std::chrono::sys_days is a business day, so each
+ * calendar type supplies its own lookup. They are constexpr so that calendars usable in constant
+ * expressions can adjust dates at compile time.
+ */
+
+namespace datelib::detail {
+
+// Maximum number of days to search for a business day (one year)
+inline constexpr int MAX_DAYS_TO_SEARCH = 366;
+
+/**
+ * @brief Move forward to the next business day
+ * @param is_business_day Predicate telling whether a std::chrono::sys_days is a business day
+ */
+template <typename IsBusinessDay>
+constexpr std::chrono::sys_days moveToNextBusinessDay(std::chrono::sys_days start,
+                                                      IsBusinessDay& is_business_day) {
+    auto adjusted = start;
+    int iterations = 0;
+
+    while (!is_business_day(adjusted)) {
+        if (++iterations > MAX_DAYS_TO_SEARCH) {
+            throw BusinessDaySearchException(
+                "Unable to find next business day within reasonable range");
+        }
+        adjusted += std::chrono::days{1};
+    }
+
+    return adjusted;
+}
+
+/**
+ * @brief Move backward to the previous business day
+ * @param is_business_day Predicate telling whether a std::chrono::sys_days is a business day
+ */
+template <typename IsBusinessDay>
+constexpr std::chrono::sys_days moveToPreviousBusinessDay(std::chrono::sys_days start,
+                                                          IsBusinessDay& is_business_day) {
+    auto adjusted = start;
+    int iterations = 0;
+
+    while (!is_business_day(adjusted)) {
+        if (++iterations > MAX_DAYS_TO_SEARCH) {
+            throw BusinessDaySearchException(
+                "Unable to find previous business day within reasonable range");
+        }
+        adjusted -= std::chrono::days{1};
+    }
+
+    return adjusted;
+}
+
+/**
+ * @brief Check whether two days fall in the same calendar month
+ */
+[[nodiscard]] constexpr bool sameMonth(std::chrono::sys_days lhs,
+                                       std::chrono::sys_days rhs) noexcept {
+    return toYearMonthDay(lhs).month() == toYearMonthDay(rhs).month();
+}
+
+/**
+ * @brief Apply a business day convention to a valid date
+ * @param is_business_day Predicate telling whether a std::chrono::sys_days is a business day
+ */
+template <typename IsBusinessDay>
+constexpr std::chrono::sys_days adjustDay(std::chrono::sys_days date,
+                                          BusinessDayConvention convention,
+                                          IsBusinessDay& is_business_day) {
+    // If already a business day, no adjustment needed
+    if (is_business_day(date)) {
+        return date;
+    }
+
+    // Apply the convention
+    using enum BusinessDayConvention;
+    switch (convention) {
+    case Following:
+        return moveToNextBusinessDay(date, is_business_day);
+
+    case ModifiedFollowing: {
+        auto adjusted = moveToNextBusinessDay(date, is_business_day);
+        // If we crossed into a new month, go backward instead
+        if (!sameMonth(adjusted, date)) {
+            adjusted = moveToPreviousBusinessDay(date, is_business_day);
+        }
+        return adjusted;
+    }
+
+    case Preceding:
+        return moveToPreviousBusinessDay(date, is_business_day);
+
+    case ModifiedPreceding: {
+        auto adjusted = moveToPreviousBusinessDay(date, is_business_day);
+        // If we crossed into a different month, go forward instead
+        if (!sameMonth(adjusted, date)) {
+            adjusted = moveToNextBusinessDay(date, is_business_day);
+        }
+        return adjusted;
+    }
+
+    case Unadjusted:
+        // Return the date unchanged
+        return date;
+    }
+
+    // This should never be reached as all enum values are handled above
+    // If we reach here, it's a logic error (e.g., uninitialized enum)
+    throw UnhandledEnumException("Unhandled BusinessDayConvention in adjust()");
+}
+
+} // namespace datelib::detail
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @file civil.h
+ * @brief Internal conversions between civil dates and day numbers
+ *
+ * These routines do the same conversions as std::chrono's sys_days and year_month_day
+ * constructors. They use the Neri-Schneider algorithms, which replace the divisions by 100, 400
+ * and the month lengths with multiplications and shifts and have no data-dependent branches.
+ * Dates before the epoch are handled by shifting the day number by a whole number of 400-year
+ * eras so that all arithmetic is on unsigned integers.
+ *
+ * Day numbers count days since 1970-01-01, like std::chrono::sys_days. Every date of the range
+ * representable by std::chrono::year (-32767 to 32767) is supported; the functions take valid
+ * dates only and do not check their arguments.
+ */
+
+namespace datelib::detail {
+
+/**
+ * @brief A Gregorian date as plain integers
+ */
+struct CivilDate {
+    std::int32_t year;
+    std::uint32_t month;
+    std::uint32_t day;
+};
+
+// Number of 400-year eras added to every year so that the computational years are positive
+inline constexpr std::uint32_t ERA_SHIFT = 82;
+
+// Years and days added by the era shift (146097 days per era; day 719468 of the computational
+// calendar, which starts on March 1st of year 0, is 1970-01-01)
+inline constexpr std::uint32_t YEAR_SHIFT = 400 * ERA_SHIFT;
+inline constexpr std::uint32_t DAY_SHIFT = 719468 + 146097 * ERA_SHIFT;
+
+// Weekday (C encoding) of shifted day number 0; 1970-01-01 was a Thursday
+inline constexpr std::uint32_t WEEKDAY_SHIFT = (4 + 7 - DAY_SHIFT % 7) % 7;
+
+/**
+ * @brief Convert a civil date to a day number
+ * @param year The year
+ * @param month The month (1-12)
+ * @param day The day of the month (1-31), valid for the month
+ */
+[[nodiscard]] constexpr std::int32_t daysFromCivil(std::int32_t year, std::uint32_t month,
+                                                   std::uint32_t day) noexcept {
+    // Computational calendar: years start on March 1st so that the leap day comes last
+    const std::uint32_t january_or_february = month <= 2 ? 1 : 0;
+    const std::uint32_t y = static_cast<std::uint32_t>(year) + YEAR_SHIFT - january_or_february;
+    const std::uint32_t m = january_or_february != 0 ? month + 12 : month;
+
+    const std::uint32_t century = y / 100;
+    const std::uint32_t year_days = 1461 * y / 4 - century + century / 4;
+    const std::uint32_t month_days = (979 * m - 2919) / 32;
+    return static_cast<std::int32_t>(year_days + month_days + day - 1 - DAY_SHIFT);
+}
+
+/**
+ * @brief Convert a day number to a civil date
+ * @param days Days since 1970-01-01
+ */
+[[nodiscard]] constexpr CivilDate civilFromDays(std::int32_t days) noexcept {
+    const std::uint32_t n = static_cast<std::uint32_t>(days) + DAY_SHIFT;
+
+    // Century and day of the century
+    const std::uint32_t n1 = 4 * n + 3;
+    const std::uint32_t century = n1 / 146097;
+    const std::uint32_t day_of_century = n1 % 146097 / 4;
+
+    // Year of the century and day of the (March-based) year
+    const std::uint32_t n2 = 4 * day_of_century + 3;
+    const std::uint64_t p2 = std::uint64_t{2939745} * n2;
+    const auto year_of_century = static_cast<std::uint32_t>(p2 >> 32);
+    const auto day_of_year = static_cast<std::uint32_t>(p2 & 0xFFFFFFFFU) / 2939745 / 4;
+
+    // Month and day of the month
+    const std::uint32_t n3 = 2141 * day_of_year + 197913;
+    const std::uint32_t month = n3 >> 16;
+    const std::uint32_t day = (n3 & 0xFFFFU) / 2141;
+
+    // Back from the March-based year: January and February belong to the next civil year
+    const std::uint32_t january_or_february = day_of_year >= 306 ? 1 : 0;
+    return {static_cast<std::int32_t>(100 * century + year_of_century + january_or_february) -
+                static_cast<std::int32_t>(YEAR_SHIFT),
+            january_or_february != 0 ? month - 12 : month, day + 1};
+}
+
+/**
+ * @brief Get the weekday of a day number
+ * @param days Days since 1970-01-01
+ * @return The weekday in C encoding (0 = Sunday, 6 = Saturday)
+ */
+[[nodiscard]] constexpr std::uint32_t weekdayFromDays(std::int32_t days) noexcept {
+    return (static_cast<std::uint32_t>(days) + DAY_SHIFT + WEEKDAY_SHIFT) % 7;
+}
+
+/**
+ * @brief Convert a valid year_month_day to sys_days
+ */
+[[nodiscard]] constexpr std::chrono::sys_days
+toSysDays(const std::chrono::year_month_day& date) noexcept {
+    return std::chrono::sys_days{std::chrono::days{
+        daysFromCivil(static_cast<int>(date.year()), static_cast<unsigned>(date.month()),
+                      static_cast<unsigned>(date.day()))}};
+}
+
+/**
+ * @brief Convert sys_days within the supported range to year_month_day
+ */
+[[nodiscard]] constexpr std::chrono::year_month_day
+toYearMonthDay(std::chrono::sys_days day) noexcept {
+    auto civil = civilFromDays(static_cast<std::int32_t>(day.time_since_epoch().count()));
+    return std::chrono::year_month_day{std::chrono::year{civil.year},
+                                       std::chrono::month{civil.month},
+                                       std::chrono::day{civil.day}};
+}
+
+/**
+ * @brief Get the weekday of sys_days within the supported range
+ */
+[[nodiscard]] constexpr std::chrono::weekday weekdayOf(std::chrono::sys_days day) noexcept {
+    return std::chrono::weekday{
+        weekdayFromDays(static_cast<std::int32_t>(day.time_since_epoch().count()))};
+}
+
+} // namespace datelib::detail
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file easter.h
+ * @brief Internal tables of Easter Sunday dates
+ *
+ * Easter is tabulated for every year from 1583, the first full year of the Gregorian calendar, to
+ * 4099, the end of the range covered by the usual published tables. Each entry is the number of
+ * days from March 21st to Easter Sunday, both in the Gregorian calendar, so it fits in a byte.
+ * The tables are computed by the compiler, so looking up Easter is a single array access.
+ */
+
+namespace datelib::detail {
+
+// First and last year of the Easter tables
+inline constexpr int EASTER_FIRST_YEAR = 1583;
+inline constexpr int EASTER_LAST_YEAR = 4099;
+
+/**
+ * @brief Days from March 21st to Western (Gregorian) Easter Sunday
+ *
+ * Anonymous Gregorian algorithm (Meeus/Jones/Butcher).
+ */
+[[nodiscard]] constexpr unsigned westernEasterOffset(int year) noexcept {
+    const int golden = year % 19;
+    const int century = year / 100;
+    const int year_of_century = year % 100;
+    const int skipped_leap_days = century / 4;
+    const int correction = (century + 8) / 25;
+    const int moon_correction = (century - correction + 1) / 3;
+    const int epact = (19 * golden + century - skipped_leap_days - moon_correction + 15) % 30;
+    const int weekday =
+        (32 + 2 * (century % 4) + 2 * (year_of_century / 4) - epact - year_of_century % 4) % 7;
+    const int adjustment = (golden + 11 * epact + 22 * weekday) / 451;
+
+    // Days after March 21st; March 22nd is the earliest possible date
+    return static_cast<unsigned>(epact + weekday - 7 * adjustment + 1);
+}
+
+/**
+ * @brief Days from March 21st to Orthodox Easter Sunday, both in the Gregorian calendar
+ *
+ * Meeus' Julian algorithm, followed by the shift from the Julian to the Gregorian calendar.
+ */
+[[nodiscard]] constexpr unsigned orthodoxEasterOffset(int year) noexcept {
+    const int epact = (19 * (year % 19) + 15) % 30;
+    const int weekday = (2 * (year % 4) + 4 * (year % 7) - epact + 34) % 7;
+
+    // Julian calendar date, as days after (Julian) March 21st
+    const int julian_offset = epact + weekday + 1;
+
+    // Days the Julian calendar lags behind the Gregorian one, from March of a century year on
+    const int century = year / 100;
+    const int lag = century - century / 4 - 2;
+    return static_cast<unsigned>(julian_offset + lag);
+}
+
+/**
+ * @brief Tabulate an Easter offset function over the supported years
+ */
+template <typename Offset>
+[[nodiscard]] constexpr auto makeEasterTable(Offset offset) noexcept {
+    std::array<std::uint8_t, EASTER_LAST_YEAR - EASTER_FIRST_YEAR + 1> table{};
+    for (int year = EASTER_FIRST_YEAR; year <= EASTER_LAST_YEAR; ++year) {
+        table[static_cast<std::size_t>(year - EASTER_FIRST_YEAR)] =
+            static_cast<std::uint8_t>(offset(year));
+    }
+    return table;
+}
+
+// Days from March 21st to Easter Sunday for each supported year
+inline constexpr auto WESTERN_EASTER_TABLE = makeEasterTable(westernEasterOffset);
+inline constexpr auto ORTHODOX_EASTER_TABLE = makeEasterTable(orthodoxEasterOffset);
+
+} // namespace datelib::detail
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "datelib/QueryStats.h"
+#include "datelib/date.h"
+#include "datelib/detail/adjust.h"
+#include "datelib/exceptions.h"
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @file stats.h
+ * @brief Internal hooks recording QueryStats
+ *
+ * Without DATELIB_ENABLE_STATS every hook is an empty inline function, so instrumented code
+ * compiles to what it would be without the hooks.
+ */
+
+namespace datelib::detail {
+
+/**
+ * @brief Get the adjust() operation of a business day convention
+ */
+constexpr StatsOperation adjustOperation(BusinessDayConvention convention) noexcept {
+    using enum BusinessDayConvention;
+    switch (convention) {
+    case Following:
+        return StatsOperation::AdjustFollowing;
+    case ModifiedFollowing:
+        return StatsOperation::AdjustModifiedFollowing;
+    case Preceding:
+        return StatsOperation::AdjustPreceding;
+    case ModifiedPreceding:
+        return StatsOperation::AdjustModifiedPreceding;
+    case Unadjusted:
+        break;
+    }
+    return StatsOperation::AdjustUnadjusted;
+}
+
+#ifdef DATELIB_ENABLE_STATS
+void recordLatency(StatsOperation operation, std::chrono::nanoseconds elapsed) noexcept;
+
+void recordRuleEvaluations(std::uint64_t count) noexcept;
+
+void recordYearBitmapBuilt() noexcept;
+
+void recordSearch(std::uint64_t days) noexcept;
+
+void recordSearchLimitExceeded() noexcept;
+
+/**
+ * @brief Record the time from construction to destruction as the latency of an operation
+ */
+class LatencyTimer {
+  public:
+    explicit LatencyTimer(StatsOperation operation) noexcept
+        : operation_(operation), start_(std::chrono::steady_clock::now()) {}
+
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+    ~LatencyTimer() { recordLatency(operation_, std::chrono::steady_clock::now() - start_); }
+
+  private:
+    StatsOperation operation_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Apply a business day convention, recording the days examined
+ *
+ * Days examined by both searches of a modified convention are added up.
+ */
+template <typename IsBusinessDay>
+std::chrono::sys_days recordedAdjustDay(std::chrono::sys_days date,
+                                        BusinessDayConvention convention,
+                                        IsBusinessDay& is_business_day) {
+    std::uint64_t days = 0;
+    auto counted = [&](std::chrono::sys_days day) {
+        ++days;
+        return is_business_day(day);
+    };
+    // adjustDay() checks the starting day once more when it has to search
+    auto examined = [&days] { return days > 1 ? days - 1 : days; };
+    try {
+        auto adjusted = adjustDay(date, convention, counted);
+        recordSearch(examined());
+        return adjusted;
+    } catch (const BusinessDaySearchException&) {
+        recordSearch(examined());
+        recordSearchLimitExceeded();
+        throw;
+    }
+}
+#else
+inline void recordRuleEvaluations(std::uint64_t /*count*/) noexcept {}
+
+inline void recordYearBitmapBuilt() noexcept {}
+
+class LatencyTimer {
+  public:
+    explicit constexpr LatencyTimer(StatsOperation /*operation*/) noexcept {}
+};
+
+template <typename IsBusinessDay>
+std::chrono::sys_days recordedAdjustDay(std::chrono::sys_days date,
+                                        BusinessDayConvention convention,
+                                        IsBusinessDay& is_business_day) {
+    return adjustDay(date, convention, is_business_day);
+}
+#endif
+
+} // namespace datelib::detail
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "datelib/YearBitmap.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @file year_cache.h
+ * @brief Internal cache of per-year bitmaps with lock-free reads of years already built
+ */
+
+namespace datelib::detail {
+
+/**
+ * @brief Bitmaps of years, built on first use and kept until cleared
+ *
+ * Years from FIRST_YEAR to FIRST_YEAR + WINDOW_YEARS - 1 are published through an array of atomic
+ * pointers: once a year is built, finding it again is an acquire load and no lock is taken, so
+ * any number of threads can read concurrently without contending. Years outside the window are
+ * found under the lock. Building a year takes the lock, so a year is built once however many
+ * threads ask for it at the same time.
+ *
+ * Bitmaps are never moved or freed before clear(), so references handed out stay valid until
+ * then.
+ */
+class YearCache {
+  public:
+    static constexpr int FIRST_YEAR = 1900;
+    static constexpr int WINDOW_YEARS = 400;
+
+    YearCache() = default;
+    YearCache(const YearCache&) = delete;
+    YearCache& operator=(const YearCache&) = delete;
+
+    /**
+     * @brief Get the bitmap of a year, building it if needed
+     * @param build Callable returning the YearBitmap of the year; called with the cache's lock
+     * held, at most once per year
+     */
+    template <typename Build>
+    const YearBitmap& get(int year, Build&& build) const {
+        const bool windowed = inWindow(year);
+        if (windowed) {
+            if (const auto* bitmap = window_[year - FIRST_YEAR].load(std::memory_order_acquire)) {
+                return *bitmap;
+            }
+        }
+
+        std::scoped_lock lock(mutex_);
+        auto& owned = years_[year];
+        if (!owned) {
+            owned = std::make_unique<const YearBitmap>(build());
+            if (windowed) {
+                window_[year - FIRST_YEAR].store(owned.get(), std::memory_order_release);
+            }
+        }
+        return *owned;
+    }
+
+    /**
+     * @brief Discard every year; requires that no other thread uses the cache
+     */
+    void clear() noexcept {
+        for (auto& slot : window_) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+        years_.clear();
+    }
+
+  private:
+    static constexpr bool inWindow(int year) noexcept {
+        return year >= FIRST_YEAR && year < FIRST_YEAR + WINDOW_YEARS;
+    }
+
+    mutable std::array<std::atomic<const YearBitmap*>, WINDOW_YEARS> window_{};
+
+    // Owns every built year, guarded by mutex_
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<int, std::unique_ptr<const YearBitmap>> years_;
+};
+
+} // namespace datelib::detail
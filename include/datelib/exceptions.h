@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
@@ -37,6 +38,44 @@ class OccurrenceNotFoundException : public std::runtime_error {
     using std::runtime_error::runtime_error;
 };
 
+/**
+ * @brief Exception thrown when a query falls outside the years covered by a compiled calendar
+ */
+class YearOutOfRangeException : public std::out_of_range {
+  public:
+    using std::out_of_range::out_of_range;
+};
+
+/**
+ * @brief Exception thrown when a calendar file cannot be written, opened or is malformed
+ */
+class CalendarFileException : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Exception thrown when a calendar definition cannot be parsed
+ */
+class CalendarParseException : public std::runtime_error {
+  public:
+    /**
+     * @brief Construct the exception for an error on a given line
+     * @param line The one-based number of the offending line
+     * @param message Description of the error
+     */
+    CalendarParseException(std::size_t line, const std::string& message)
+        : std::runtime_error("Line " + std::to_string(line) + ": " + message), line_(line) {}
+
+    /**
+     * @brief Get the one-based number of the offending line
+     */
+    [[nodiscard]] std::size_t line() const noexcept { return line_; }
+
+  private:
+    std::size_t line_;
+};
+
 /**
  * @brief Exception thrown when an enum value is not handled in a switch statement
  */
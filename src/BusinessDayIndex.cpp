@@ -0,0 +1,166 @@
+#include "datelib/BusinessDayIndex.h"
+
+#include "datelib/date.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace datelib {
+
+using std::chrono::days;
+using std::chrono::sys_days;
+using std::chrono::year_month_day;
+
+namespace {
+/**
+ * @brief Validate a date and convert it to a day count
+ */
+sys_days toSysDays(const year_month_day& date, const char* message) {
+    if (!date.ok()) {
+        throw std::invalid_argument(message);
+    }
+    return sys_days{date};
+}
+} // namespace
+
+BusinessDayIndex::BusinessDayIndex(const HolidayCalendar& calendar, int first_year, int last_year,
+                                   WeekendMask weekend)
+    : calendar_(calendar), weekend_(weekend), first_year_(first_year), last_year_(last_year),
+      first_day_{std::chrono::year{first_year} / std::chrono::January / 1},
+      end_day_{std::chrono::year{last_year + 1} / std::chrono::January / 1} {
+    if (last_year < first_year) {
+        throw std::invalid_argument("Last year must not be before first year");
+    }
+
+    prefix_.reserve(static_cast<std::size_t>((end_day_ - first_day_).count()) + 1);
+    prefix_.push_back(0);
+    for (int year = first_year; year <= last_year; ++year) {
+        auto bitmap = calendar_.getBusinessDayBitmap(year, weekend_);
+        auto length = YearBitmap::lengthOf(year);
+        for (unsigned index = 0; index < length; ++index) {
+            if (bitmap.test(index)) {
+                business_days_.push_back(static_cast<std::int32_t>(prefix_.size() - 1));
+            }
+            prefix_.push_back(static_cast<std::int32_t>(business_days_.size()));
+        }
+    }
+}
+
+bool BusinessDayIndex::contains(const year_month_day& date) const noexcept {
+    if (!date.ok()) {
+        return false;
+    }
+    sys_days day{date};
+    return day >= first_day_ && day < end_day_;
+}
+
+bool BusinessDayIndex::isBusinessDay(const year_month_day& date) const {
+    auto day = toSysDays(date, "Invalid date provided to isBusinessDay");
+    if (day < first_day_ || day >= end_day_) {
+        return datelib::isBusinessDay(date, calendar_, weekend_);
+    }
+    auto offset = static_cast<std::size_t>((day - first_day_).count());
+    return prefix_[offset + 1] != prefix_[offset];
+}
+
+int BusinessDayIndex::businessDaysBetween(const year_month_day& from,
+                                          const year_month_day& to) const {
+    auto first = toSysDays(from, "Invalid date provided to businessDaysBetween");
+    auto last = toSysDays(to, "Invalid date provided to businessDaysBetween");
+    return first <= last ? countForward(first, last) : -countForward(last, first);
+}
+
+void BusinessDayIndex::businessDaysBetween(std::span<const sys_days> from,
+                                           std::span<const sys_days> to,
+                                           std::span<int> counts) const {
+    if (to.size() != from.size() || counts.size() != from.size()) {
+        throw std::invalid_argument("Input and output spans must have the same size");
+    }
+
+    // prefix_ has an entry for every day of the horizon and one for its end
+    const auto last_offset = static_cast<std::uint64_t>(prefix_.size() - 1);
+    for (std::size_t i = 0; i < from.size(); ++i) {
+        // Days before the horizon wrap around to large unsigned offsets
+        auto first = static_cast<std::uint64_t>((from[i] - first_day_).count());
+        auto last = static_cast<std::uint64_t>((to[i] - first_day_).count());
+        if (first <= last_offset && last <= last_offset) {
+            counts[i] = prefix_[last] - prefix_[first];
+        } else {
+            counts[i] = from[i] <= to[i] ? countForward(from[i], to[i])
+                                         : -countForward(to[i], from[i]);
+        }
+    }
+}
+
+int BusinessDayIndex::businessDayOfMonth(const year_month_day& date) const {
+    auto day = toSysDays(date, "Invalid date provided to businessDayOfMonth");
+    sys_days month_start{date.year() / date.month() / 1};
+    return countForward(month_start, day + days{1});
+}
+
+int BusinessDayIndex::businessDayOfYear(const year_month_day& date) const {
+    auto day = toSysDays(date, "Invalid date provided to businessDayOfYear");
+    sys_days year_start{date.year() / std::chrono::January / 1};
+    return countForward(year_start, day + days{1});
+}
+
+year_month_day BusinessDayIndex::addBusinessDays(const year_month_day& date, int n) const {
+    auto day = toSysDays(date, "Invalid date provided to addBusinessDays");
+    if (day < first_day_ || day >= end_day_) {
+        return datelib::addBusinessDays(date, n, calendar_, weekend_);
+    }
+
+    // Rank of the target among the indexed business days: prefix_[offset] business days lie
+    // before the date and prefix_[offset + 1] lie on or before it
+    auto offset = static_cast<std::size_t>((day - first_day_).count());
+    std::int64_t rank = n > 0 ? std::int64_t{prefix_[offset + 1]} + n - 1
+                              : std::int64_t{prefix_[offset]} + n;
+    if (rank < 0 || rank >= static_cast<std::int64_t>(business_days_.size())) {
+        return datelib::addBusinessDays(date, n, calendar_, weekend_);
+    }
+    return year_month_day{first_day_ + days{business_days_[static_cast<std::size_t>(rank)]}};
+}
+
+int BusinessDayIndex::countForward(sys_days from, sys_days to) const {
+    int total = 0;
+
+    // Part of the range covered by the index
+    auto indexed_from = std::max(from, first_day_);
+    auto indexed_to = std::min(to, end_day_);
+    if (indexed_from < indexed_to) {
+        total += prefix_[static_cast<std::size_t>((indexed_to - first_day_).count())] -
+                 prefix_[static_cast<std::size_t>((indexed_from - first_day_).count())];
+    }
+
+    // Parts of the range before and after the horizon
+    if (from < first_day_) {
+        total += countUnindexed(from, std::min(to, first_day_));
+    }
+    if (to > end_day_) {
+        total += countUnindexed(std::max(from, end_day_), to);
+    }
+
+    return total;
+}
+
+int BusinessDayIndex::countUnindexed(sys_days from, sys_days to) const {
+    int total = 0;
+
+    while (from < to) {
+        year_month_day date{from};
+        auto year = static_cast<int>(date.year());
+        sys_days next_year{std::chrono::year{year + 1} / std::chrono::January / 1};
+        auto stop = std::min(to, next_year);
+
+        auto first = YearBitmap::indexOf(date);
+        auto last = first + static_cast<unsigned>((stop - from).count());
+        auto bitmap = calendar_.getBusinessDayBitmap(year, weekend_);
+        total += static_cast<int>(bitmap.count(first, last));
+
+        from = stop;
+    }
+
+    return total;
+}
+
+} // namespace datelib
@@ -0,0 +1,234 @@
+#include "datelib/CalendarLoader.h"
+
+#include "datelib/HolidayCalendar.h"
+#include "datelib/exceptions.h"
+
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace datelib {
+
+using std::chrono::year_month_day;
+
+namespace {
+// Size of the blocks read from a stream; a longer line grows the buffer
+constexpr std::size_t BLOCK_SIZE = std::size_t{1} << 20;
+
+/**
+ * @brief Parser of complete definition lines into a calendar
+ *
+ * Rules are added as their lines are parsed. Explicit holidays are collected as views into the
+ * parsed text and added in one call by flush(), which must happen before that text changes.
+ */
+class DefinitionParser {
+  public:
+    DefinitionParser(HolidayCalendar& calendar, LoadStatistics& statistics)
+        : calendar_(calendar), statistics_(statistics) {}
+
+    /**
+     * @brief Parse a block of complete lines (the last one may lack its line ending)
+     */
+    void parse(std::string_view text) {
+        while (!text.empty()) {
+            auto end = text.find('\n');
+            auto line = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+            ++statistics_.lines;
+            if (line.ends_with('\r')) {
+                line.remove_suffix(1);
+            }
+            if (!line.empty() && !line.starts_with('#')) {
+                parseLine(line);
+            }
+        }
+    }
+
+    /**
+     * @brief Add the explicit holidays collected since the last flush
+     */
+    void flush() {
+        if (pending_.empty()) {
+            return;
+        }
+        calendar_.addHolidays(pending_);
+        statistics_.holidays += pending_.size();
+        pending_.clear();
+    }
+
+  private:
+    void parseLine(std::string_view line) {
+        auto kind = nextField(line);
+        if (kind == "date") {
+            auto date = parseDate(nextField(line));
+            pending_.emplace_back(parseName(line), date);
+        } else if (kind == "fixed") {
+            auto month = parseNumber<unsigned>(nextField(line), "month");
+            auto day = parseNumber<unsigned>(nextField(line), "day");
+            addRule<FixedDateRule>(parseName(line), month, day);
+        } else if (kind == "nth") {
+            auto month = parseNumber<unsigned>(nextField(line), "month");
+            auto weekday = parseNumber<unsigned>(nextField(line), "weekday");
+            auto occurrence = parseOccurrence(nextField(line));
+            addRule<NthWeekdayRule>(parseName(line), month, weekday, occurrence);
+        } else if (kind == "easter") {
+            auto offset = parseNumber<int>(nextField(line), "offset");
+            auto type = parseEasterType(nextField(line));
+            addRule<EasterOffsetRule>(parseName(line), offset, type);
+        } else {
+            fail("Unknown definition type '" + std::string(kind) + "'");
+        }
+    }
+
+    /**
+     * @brief Build a rule, reporting invalid arguments as a parse error
+     */
+    template <typename Rule, typename... Args>
+    void addRule(std::string_view name, Args... args) {
+        try {
+            calendar_.addRule(std::make_unique<Rule>(std::string(name), args...));
+        } catch (const std::invalid_argument& e) {
+            fail(e.what());
+        }
+        ++statistics_.rules;
+    }
+
+    /**
+     * @brief Take the next comma-separated field off the front of a line
+     */
+    std::string_view nextField(std::string_view& line) const {
+        auto comma = line.find(',');
+        if (comma == std::string_view::npos) {
+            fail("Expected more fields");
+        }
+        auto field = line.substr(0, comma);
+        line.remove_prefix(comma + 1);
+        return field;
+    }
+
+    std::string_view parseName(std::string_view rest) const {
+        if (rest.empty()) {
+            fail("Missing holiday name");
+        }
+        return rest;
+    }
+
+    template <typename T>
+    T parseNumber(std::string_view field, const char* what) const {
+        T value{};
+        auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+        if (error != std::errc{} || end != field.data() + field.size() || field.empty()) {
+            fail(std::string("Invalid ") + what + " '" + std::string(field) + "'");
+        }
+        return value;
+    }
+
+    year_month_day parseDate(std::string_view field) const {
+        // YYYY-MM-DD; the year may be negative, but from_chars() rejects a leading '+'
+        auto separator = field.find('-', 1);
+        auto second = separator == std::string_view::npos ? separator
+                                                           : field.find('-', separator + 1);
+        if (second == std::string_view::npos) {
+            fail("Invalid date '" + std::string(field) + "'");
+        }
+
+        year_month_day date{
+            std::chrono::year{parseNumber<int>(field.substr(0, separator), "year")},
+            std::chrono::month{
+                parseNumber<unsigned>(field.substr(separator + 1, second - separator - 1),
+                                      "month")},
+            std::chrono::day{parseNumber<unsigned>(field.substr(second + 1), "day")}};
+        if (!date.ok()) {
+            fail("Invalid date '" + std::string(field) + "'");
+        }
+        return date;
+    }
+
+    Occurrence parseOccurrence(std::string_view field) const {
+        if (field == "last") {
+            return Occurrence::Last;
+        }
+        return static_cast<Occurrence>(parseNumber<int>(field, "occurrence"));
+    }
+
+    EasterType parseEasterType(std::string_view field) const {
+        if (field == "western") {
+            return EasterType::Western;
+        }
+        if (field == "orthodox") {
+            return EasterType::Orthodox;
+        }
+        fail("Invalid Easter type '" + std::string(field) + "'");
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw CalendarParseException(statistics_.lines, message);
+    }
+
+    HolidayCalendar& calendar_;
+    LoadStatistics& statistics_;
+    std::vector<std::pair<std::string_view, year_month_day>> pending_;
+};
+} // namespace
+
+LoadStatistics loadCalendar(std::istream& input, HolidayCalendar& calendar) {
+    auto start = std::chrono::steady_clock::now();
+    LoadStatistics statistics;
+
+    // Work on a copy, which shares the calendar's state until the first change, so that a parse
+    // error leaves the calendar unchanged
+    HolidayCalendar staged = calendar;
+    DefinitionParser parser(staged, statistics);
+
+    std::string buffer(BLOCK_SIZE, '\0');
+    std::size_t filled = 0;
+    for (bool at_end = false; !at_end;) {
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        input.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+        auto count = static_cast<std::size_t>(input.gcount());
+        if (input.bad()) {
+            throw CalendarFileException("Unable to read calendar definitions");
+        }
+        at_end = input.eof();
+        filled += count;
+        statistics.bytes += count;
+
+        // Parse complete lines only; a partial last line waits for the next block (npos + 1 is 0
+        // when the block holds no line ending yet)
+        std::string_view text(buffer.data(), filled);
+        auto complete = at_end ? filled : text.rfind('\n') + 1;
+        parser.parse(text.substr(0, complete));
+        parser.flush();
+
+        std::memmove(buffer.data(), buffer.data() + complete, filled - complete);
+        filled -= complete;
+    }
+
+    calendar = std::move(staged);
+    statistics.elapsed = std::chrono::steady_clock::now() - start;
+    return statistics;
+}
+
+LoadStatistics loadCalendar(std::string_view text, HolidayCalendar& calendar) {
+    auto start = std::chrono::steady_clock::now();
+    LoadStatistics statistics;
+    statistics.bytes = text.size();
+
+    HolidayCalendar staged = calendar;
+    DefinitionParser parser(staged, statistics);
+    parser.parse(text);
+    parser.flush();
+
+    calendar = std::move(staged);
+    statistics.elapsed = std::chrono::steady_clock::now() - start;
+    return statistics;
+}
+
+} // namespace datelib
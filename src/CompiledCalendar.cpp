@@ -0,0 +1,100 @@
+#include "datelib/CompiledCalendar.h"
+
+#include "datelib/HolidayNames.h"
+#include "datelib/detail/stats.h"
+#include "datelib/exceptions.h"
+
+#include <algorithm>
+
+namespace datelib {
+
+using std::chrono::sys_days;
+using std::chrono::year_month_day;
+
+CompiledCalendar::CompiledCalendar(int first_year, int last_year,
+                                   std::vector<std::pair<sys_days, std::uint32_t>> entries)
+    : first_year_(first_year), last_year_(last_year),
+      bitmaps_(static_cast<std::size_t>(last_year - first_year) + 1) {
+    // Group the entries by day, keeping rule order among the names of a day
+    std::ranges::stable_sort(entries, {}, &std::pair<sys_days, std::uint32_t>::first);
+
+    holidays_.reserve(entries.size());
+    name_offsets_.reserve(entries.size() + 1);
+    name_ids_.reserve(entries.size());
+
+    for (const auto& [day, name_id] : entries) {
+        if (holidays_.empty() || holidays_.back() != day) {
+            year_month_day date{day};
+            bitmaps_[yearSlot(static_cast<int>(date.year()))].set(YearBitmap::indexOf(date));
+            holidays_.push_back(day);
+            name_offsets_.push_back(static_cast<std::uint32_t>(name_ids_.size()));
+        }
+        name_ids_.push_back(name_id);
+    }
+    name_offsets_.push_back(static_cast<std::uint32_t>(name_ids_.size()));
+}
+
+bool CompiledCalendar::contains(const year_month_day& date) const noexcept {
+    if (!date.ok()) {
+        return false;
+    }
+    auto year = static_cast<int>(date.year());
+    return year >= first_year_ && year <= last_year_;
+}
+
+bool CompiledCalendar::isHoliday(const year_month_day& date) const {
+    detail::LatencyTimer timer(StatsOperation::IsHoliday);
+    if (!date.ok()) {
+        return false;
+    }
+    return bitmaps_[yearSlot(static_cast<int>(date.year()))].test(YearBitmap::indexOf(date));
+}
+
+std::vector<year_month_day> CompiledCalendar::getHolidays(int year) const {
+    detail::LatencyTimer timer(StatsOperation::GetHolidays);
+    const auto& bitmap = bitmaps_[yearSlot(year)];
+
+    std::vector<year_month_day> holidays;
+    holidays.reserve(bitmap.count());
+    bitmap.forEach([&](unsigned index) { holidays.push_back(YearBitmap::dateAt(year, index)); });
+
+    return holidays;
+} // LCOV_EXCL_LINE
+
+std::vector<std::string> CompiledCalendar::getHolidayNames(const year_month_day& date) const {
+    std::vector<std::string> names;
+    for (auto id : getHolidayNameIds(date)) {
+        names.emplace_back(holidayName(id));
+    }
+    return names;
+} // LCOV_EXCL_LINE
+
+std::span<const std::uint32_t>
+CompiledCalendar::getHolidayNameIds(const year_month_day& date) const {
+    if (!isHoliday(date)) {
+        return {};
+    }
+
+    auto it = std::ranges::lower_bound(holidays_, sys_days{date});
+    auto position = static_cast<std::size_t>(it - holidays_.begin());
+    return std::span{name_ids_}.subspan(name_offsets_[position],
+                                        name_offsets_[position + 1] - name_offsets_[position]);
+}
+
+const YearBitmap& CompiledCalendar::getHolidayBitmap(int year) const {
+    return bitmaps_[yearSlot(year)];
+}
+
+YearBitmap CompiledCalendar::getBusinessDayBitmap(int year, WeekendMask weekend) const {
+    return YearBitmap::allDays(year) & ~(getHolidayBitmap(year) | weekend.daysIn(year));
+}
+
+std::size_t CompiledCalendar::yearSlot(int year) const {
+    if (year < first_year_ || year > last_year_) {
+        throw YearOutOfRangeException("Year " + std::to_string(year) +
+                                      " is outside the range of the compiled calendar");
+    }
+    return static_cast<std::size_t>(year - first_year_);
+}
+
+} // namespace datelib
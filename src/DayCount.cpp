@@ -0,0 +1,253 @@
+#include "datelib/DayCount.h"
+
+#include "datelib/BusinessDayIndex.h"
+#include "datelib/detail/civil.h"
+#include "datelib/exceptions.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define DATELIB_HAS_AVX2_KERNEL 1
+#endif
+
+namespace datelib {
+
+using std::chrono::sys_days;
+using std::chrono::year_month_day;
+
+namespace {
+// Number of periods whose business days are counted at a time for BUS/252
+constexpr std::size_t BUSINESS_DAY_CHUNK = 256;
+
+constexpr double BUSINESS_DAYS_PER_YEAR = 252.0;
+
+/**
+ * @brief Get the day number of a day within the range supported by the civil conversions
+ */
+constexpr std::int32_t dayNumber(sys_days day) noexcept {
+    return static_cast<std::int32_t>(day.time_since_epoch().count());
+}
+
+/**
+ * @brief Year fraction of a 30/360 period from its civil dates and adjusted days of month
+ */
+constexpr double thirty360(const detail::CivilDate& start, const detail::CivilDate& end,
+                           std::int32_t start_day, std::int32_t end_day) noexcept {
+    const std::int32_t days = 360 * (end.year - start.year) +
+                              30 * (static_cast<std::int32_t>(end.month) -
+                                    static_cast<std::int32_t>(start.month)) +
+                              end_day - start_day;
+    return days / 360.0;
+}
+
+// Each convention maps a period, as two day numbers, to its year fraction. The functions are
+// branch-free (selects only) so that the loops calling them vectorize.
+
+struct Actual360 {
+    static constexpr double fraction(std::int32_t start, std::int32_t end) noexcept {
+        return (end - start) / 360.0;
+    }
+};
+
+struct Actual365Fixed {
+    static constexpr double fraction(std::int32_t start, std::int32_t end) noexcept {
+        return (end - start) / 365.0;
+    }
+};
+
+struct Thirty360 {
+    static constexpr double fraction(std::int32_t start, std::int32_t end) noexcept {
+        const auto first = detail::civilFromDays(start);
+        const auto last = detail::civilFromDays(end);
+        const auto start_day = std::min(static_cast<std::int32_t>(first.day), 30);
+        const auto end_day = last.day == 31 && start_day == 30
+                                 ? 30
+                                 : static_cast<std::int32_t>(last.day);
+        return thirty360(first, last, start_day, end_day);
+    }
+};
+
+struct ThirtyE360 {
+    static constexpr double fraction(std::int32_t start, std::int32_t end) noexcept {
+        const auto first = detail::civilFromDays(start);
+        const auto last = detail::civilFromDays(end);
+        return thirty360(first, last, std::min(static_cast<std::int32_t>(first.day), 30),
+                         std::min(static_cast<std::int32_t>(last.day), 30));
+    }
+};
+
+/**
+ * @brief Get the year of a day number
+ *
+ * Unlike civilFromDays(), this never looks at the month, which compilers turn into a branch that
+ * stops the ACT/ACT loop from vectorizing. The year is estimated from the mean length of a year,
+ * which is never off by more than one, and corrected against the day numbers of January 1st.
+ */
+constexpr std::int32_t yearOf(std::int32_t days) noexcept {
+    constexpr std::uint32_t DAYS_PER_ERA = 146097;
+    constexpr std::uint32_t DAYS_FROM_YEAR_ONE = 719162; // 0001-01-01 to 1970-01-01
+
+    const std::uint32_t shifted = static_cast<std::uint32_t>(days) + DAYS_FROM_YEAR_ONE +
+                                  DAYS_PER_ERA * detail::ERA_SHIFT;
+    const std::uint32_t estimate =
+        shifted / DAYS_PER_ERA * 400 + shifted % DAYS_PER_ERA * 400 / DAYS_PER_ERA;
+    auto year =
+        static_cast<std::int32_t>(estimate) + 1 - static_cast<std::int32_t>(detail::YEAR_SHIFT);
+    year -= static_cast<std::int32_t>(days < detail::daysFromCivil(year, 1, 1));
+    year += static_cast<std::int32_t>(days >= detail::daysFromCivil(year + 1, 1, 1));
+    return year;
+}
+
+struct ActualActualISDA {
+    static constexpr double fraction(std::int32_t start, std::int32_t end) noexcept {
+        const auto from = std::min(start, end);
+        const auto to = std::max(start, end);
+        const auto first_year = yearOf(from);
+        const auto last_year = yearOf(to);
+
+        // The part of the first year, the whole years between, and the part of the last year.
+        // Within one year the period is all first part, so that the fraction is the plain ratio.
+        // The parts are picked by multiplying with 0 or 1: compilers turn selects here into
+        // branches, which would stop the loop from vectorizing
+        const std::int32_t spanning = last_year != first_year ? 1 : 0;
+        const auto first_start = detail::daysFromCivil(first_year, 1, 1);
+        const auto first_end = detail::daysFromCivil(first_year + 1, 1, 1);
+        const auto last_start = detail::daysFromCivil(last_year, 1, 1);
+        const auto last_end = detail::daysFromCivil(last_year + 1, 1, 1);
+        const auto first_part = to - from + spanning * (first_end - to);
+        const auto last_part = spanning * (to - last_start);
+        const auto whole_years = last_year - first_year - spanning;
+        const double fraction = first_part / static_cast<double>(first_end - first_start) +
+                                whole_years +
+                                last_part / static_cast<double>(last_end - last_start);
+        return fraction * (start <= end ? 1 : -1);
+    }
+};
+
+template <typename Convention>
+void fractionsScalar(const sys_days* starts, const sys_days* ends, double* fractions,
+                     std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        fractions[i] = Convention::fraction(dayNumber(starts[i]), dayNumber(ends[i]));
+    }
+}
+
+#ifdef DATELIB_HAS_AVX2_KERNEL
+/**
+ * @brief The same loop as fractionsScalar(), compiled for AVX2
+ */
+template <typename Convention>
+__attribute__((target("avx2"))) void fractionsAvx2(const sys_days* starts, const sys_days* ends,
+                                                   double* fractions, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        fractions[i] = Convention::fraction(dayNumber(starts[i]), dayNumber(ends[i]));
+    }
+}
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+}
+#endif
+
+template <typename Convention>
+void computeFractions(std::span<const sys_days> starts, std::span<const sys_days> ends,
+                      std::span<double> fractions) {
+#ifdef DATELIB_HAS_AVX2_KERNEL
+    if (hasAvx2()) {
+        fractionsAvx2<Convention>(starts.data(), ends.data(), fractions.data(), starts.size());
+        return;
+    }
+#endif
+    fractionsScalar<Convention>(starts.data(), ends.data(), fractions.data(), starts.size());
+}
+
+/**
+ * @brief Validate a date and convert it to a day count
+ */
+sys_days toSysDays(const year_month_day& date) {
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to yearFraction");
+    }
+    return sys_days{date};
+}
+
+[[noreturn]] void throwBusiness252() {
+    throw std::invalid_argument("BUS/252 year fractions need a BusinessDayIndex");
+}
+
+void checkSizes(std::span<const sys_days> starts, std::span<const sys_days> ends,
+                std::span<double> fractions) {
+    if (ends.size() != starts.size() || fractions.size() != starts.size()) {
+        throw std::invalid_argument("Input and output spans must have the same size");
+    }
+}
+} // namespace
+
+double yearFraction(const year_month_day& start, const year_month_day& end,
+                    DayCountConvention convention) {
+    auto first = dayNumber(toSysDays(start));
+    auto last = dayNumber(toSysDays(end));
+
+    switch (convention) {
+    case DayCountConvention::Actual360:
+        return Actual360::fraction(first, last);
+    case DayCountConvention::Actual365Fixed:
+        return Actual365Fixed::fraction(first, last);
+    case DayCountConvention::Thirty360:
+        return Thirty360::fraction(first, last);
+    case DayCountConvention::ThirtyE360:
+        return ThirtyE360::fraction(first, last);
+    case DayCountConvention::ActualActualISDA:
+        return ActualActualISDA::fraction(first, last);
+    case DayCountConvention::Business252:
+        throwBusiness252();
+    }
+    throw UnhandledEnumException("Unhandled DayCountConvention in yearFraction()");
+}
+
+double yearFraction(const year_month_day& start, const year_month_day& end,
+                    const BusinessDayIndex& index) {
+    return index.businessDaysBetween(start, end) / BUSINESS_DAYS_PER_YEAR;
+}
+
+void yearFractions(std::span<const sys_days> starts, std::span<const sys_days> ends,
+                   std::span<double> fractions, DayCountConvention convention) {
+    checkSizes(starts, ends, fractions);
+
+    switch (convention) {
+    case DayCountConvention::Actual360:
+        return computeFractions<Actual360>(starts, ends, fractions);
+    case DayCountConvention::Actual365Fixed:
+        return computeFractions<Actual365Fixed>(starts, ends, fractions);
+    case DayCountConvention::Thirty360:
+        return computeFractions<Thirty360>(starts, ends, fractions);
+    case DayCountConvention::ThirtyE360:
+        return computeFractions<ThirtyE360>(starts, ends, fractions);
+    case DayCountConvention::ActualActualISDA:
+        return computeFractions<ActualActualISDA>(starts, ends, fractions);
+    case DayCountConvention::Business252:
+        throwBusiness252();
+    }
+    throw UnhandledEnumException("Unhandled DayCountConvention in yearFractions()");
+}
+
+void yearFractions(std::span<const sys_days> starts, std::span<const sys_days> ends,
+                   std::span<double> fractions, const BusinessDayIndex& index) {
+    checkSizes(starts, ends, fractions);
+
+    std::array<int, BUSINESS_DAY_CHUNK> counts{};
+    for (std::size_t first = 0; first < starts.size(); first += BUSINESS_DAY_CHUNK) {
+        auto size = std::min(BUSINESS_DAY_CHUNK, starts.size() - first);
+        index.businessDaysBetween(starts.subspan(first, size), ends.subspan(first, size),
+                                  std::span{counts}.first(size));
+        for (std::size_t i = 0; i < size; ++i) {
+            fractions[first + i] = counts[i] / BUSINESS_DAYS_PER_YEAR;
+        }
+    }
+}
+
+} // namespace datelib
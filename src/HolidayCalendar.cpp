@@ -1,78 +1,436 @@
 #include "datelib/HolidayCalendar.h"
 
+#include "datelib/detail/stats.h"
+
 #include <algorithm>
-#include <ranges>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
 
 namespace datelib {
 
+using std::chrono::sys_days;
 using std::chrono::year_month_day;
 
-HolidayCalendar::HolidayCalendar(const HolidayCalendar& other) {
-    // Deep copy the rules
-    rules_.reserve(other.rules_.size());
-    for (const auto& rule : other.rules_) {
-        rules_.push_back(rule->clone());
-    }
+namespace {
+/**
+ * @brief Get the first day of a year
+ */
+sys_days startOf(int year) {
+    return sys_days{std::chrono::year{year} / std::chrono::January / 1};
+}
+
+/**
+ * @brief Evaluate a built-in rule stored by value
+ * @return The rule's date in the year, or std::nullopt if the rule does not apply to the year
+ */
+template <typename Rule>
+std::optional<year_month_day> dateIn(const Rule& rule, int year) noexcept {
+    // The stored type is exact, so a qualified call skips the virtual dispatch
+    return rule.Rule::tryCalculate(year);
+}
+
+/**
+ * @brief Evaluate a rule of any other type through the HolidayRule interface
+ */
+std::optional<year_month_day> dateIn(const std::shared_ptr<const HolidayRule>& rule,
+                                     int year) noexcept {
+    return rule->tryCalculate(year);
+}
+
+template <typename Rule>
+std::uint32_t nameIdOf(const Rule& rule) {
+    return rule.Rule::getNameId();
+}
+
+std::uint32_t nameIdOf(const std::shared_ptr<const HolidayRule>& rule) {
+    return rule->getNameId();
+}
+
+/**
+ * @brief Check whether a rule may place its date for a year in another year
+ *
+ * Only an ObservedRule, or a class derived from it, moves holidays across a year boundary. Other
+ * rules are evaluated for the year asked for alone, and their dates in other years are ignored.
+ */
+template <typename Rule>
+constexpr bool mayLeaveYear(const Rule& /*rule*/) noexcept {
+    return false;
+}
+
+bool mayLeaveYear(const std::shared_ptr<const HolidayRule>& rule) noexcept {
+    return dynamic_cast<const ObservedRule*>(rule.get()) != nullptr;
 }
 
-HolidayCalendar& HolidayCalendar::operator=(const HolidayCalendar& other) {
+/**
+ * @brief Call a function with every date a stored rule places in a year
+ *
+ * Rules that may leave their year are also evaluated for the adjacent years, so a holiday
+ * observed across a year boundary belongs to the year it falls in.
+ */
+template <typename... Rules, typename Function>
+void forEachRuleDate(const std::variant<Rules...>& rule, int year, Function&& function) {
+    std::visit(
+        [year, &function](const auto& alternative) {
+            const std::chrono::year target{year};
+            const bool adjacent = mayLeaveYear(alternative);
+            const int first = adjacent && year > std::numeric_limits<int>::min() ? year - 1 : year;
+            const int last = adjacent && year < std::numeric_limits<int>::max() ? year + 1 : year;
+            detail::recordRuleEvaluations(static_cast<std::uint64_t>(last - first) + 1);
+            for (int base = first;; ++base) {
+                auto date = dateIn(alternative, base);
+                if (date && date->ok() && date->year() == target) {
+                    function(*date);
+                }
+                if (base == last) {
+                    break;
+                }
+            }
+        },
+        rule);
+}
+
+/**
+ * @brief Get the name ID of a stored rule
+ */
+template <typename... Rules>
+std::uint32_t ruleNameId(const std::variant<Rules...>& rule) {
+    return std::visit([](const auto& alternative) { return nameIdOf(alternative); }, rule);
+}
+
+/**
+ * @brief A date placed by a rule, with the rule's position in the calendar
+ */
+struct RuleDate {
+    sys_days day;
+    std::uint32_t rule;
+
+    // By day, then by rule, so that each day keeps its rules in the order they were added
+    friend auto operator<=>(const RuleDate&, const RuleDate&) = default;
+};
+
+// Rule dates of a year held on the stack by visitHolidays(); calendars with more spill to the heap
+constexpr std::size_t STACK_RULE_DATES = 64;
+} // namespace
+
+HolidayCalendar::HolidayCalendar() noexcept : state_(emptyState()) {}
+
+HolidayCalendar::HolidayCalendar(HolidayCalendar&& other) noexcept
+    : state_(std::exchange(other.state_, emptyState())) {}
+
+HolidayCalendar& HolidayCalendar::operator=(HolidayCalendar&& other) noexcept {
     if (this != &other) {
-        // Deep copy the rules
-        rules_.clear();
-        rules_.reserve(other.rules_.size());
-        for (const auto& rule : other.rules_) {
-            rules_.push_back(rule->clone());
-        }
+        state_ = std::exchange(other.state_, emptyState());
     }
     return *this;
 }
 
 void HolidayCalendar::addHoliday(const std::string& name, const year_month_day& date) {
-    rules_.push_back(std::make_unique<ExplicitDateRule>(name, date));
+    addHolidays(name, std::span{&date, 1});
 }
 
-void HolidayCalendar::addRule(std::unique_ptr<HolidayRule> rule) {
-    rules_.push_back(std::move(rule));
+void HolidayCalendar::addHolidays(const std::string& name,
+                                  std::span<const year_month_day> dates) {
+    if (!std::ranges::all_of(dates, [](const year_month_day& date) { return date.ok(); })) {
+        throw std::invalid_argument("Invalid date");
+    }
+
+    auto name_id = internHolidayName(name);
+    auto& state = mutableState();
+    state.explicit_holidays.reserve(state.explicit_holidays.size() + dates.size());
+    for (const auto& date : dates) {
+        sys_days day{date};
+        // Dates arriving in order keep the array sorted; anything else defers to one sort
+        if (!state.explicit_holidays.empty() && day < state.explicit_holidays.back().day) {
+            state.explicit_sorted = false;
+        }
+        state.explicit_holidays.push_back({day, name_id});
+    }
 }
 
-bool HolidayCalendar::isHoliday(const year_month_day& date) const {
-    auto year = static_cast<int>(date.year());
+void HolidayCalendar::addHolidays(
+    std::span<const std::pair<std::string_view, year_month_day>> holidays) {
+    if (!std::ranges::all_of(holidays, [](const auto& holiday) { return holiday.second.ok(); })) {
+        throw std::invalid_argument("Invalid date");
+    }
 
-    return std::ranges::any_of(rules_, [&](const auto& rule) {
-        return rule->appliesTo(year) && rule->calculateDate(year) == date;
-    });
+    auto& state = mutableState();
+    state.explicit_holidays.reserve(state.explicit_holidays.size() + holidays.size());
+
+    // Loaded dates usually come in runs sharing a name, which then take the table's lock once
+    std::optional<std::string_view> last_name;
+    std::uint32_t last_name_id = 0;
+    for (const auto& [name, date] : holidays) {
+        sys_days day{date};
+        if (!state.explicit_holidays.empty() && day < state.explicit_holidays.back().day) {
+            state.explicit_sorted = false;
+        }
+        if (last_name != name) {
+            last_name_id = internHolidayName(name);
+            last_name = name;
+        }
+        state.explicit_holidays.push_back({day, last_name_id});
+    }
 }
 
-std::vector<year_month_day> HolidayCalendar::getHolidays(int year) const {
-    std::vector<year_month_day> holidays;
-    holidays.reserve(rules_.size());
+void HolidayCalendar::addRule(std::unique_ptr<HolidayRule> rule) {
+    auto stored = storeRule(std::move(rule));
+    auto name_id = ruleNameId(stored);
+    auto& state = mutableState();
+    state.rules.push_back(std::move(stored));
+    state.rule_name_ids.push_back(name_id);
+}
 
-    // Collect all holidays from rules that apply to this year
-    for (const auto& rule : rules_) {
-        if (rule->appliesTo(year)) {
-            holidays.push_back(rule->calculateDate(year));
-        }
+bool HolidayCalendar::isHoliday(const year_month_day& date) const {
+    detail::LatencyTimer timer(StatsOperation::IsHoliday);
+    if (!date.ok()) {
+        return false;
     }
+    return getHolidayBitmap(static_cast<int>(date.year())).test(YearBitmap::indexOf(date));
+}
 
-    // Sort and remove duplicates
-    std::ranges::sort(holidays);
-    auto [new_end, end] = std::ranges::unique(holidays);
-    holidays.erase(new_end, end);
+std::vector<year_month_day> HolidayCalendar::getHolidays(int year) const {
+    detail::LatencyTimer timer(StatsOperation::GetHolidays);
+    const auto& bitmap = getHolidayBitmap(year);
+
+    // Bits are visited in ascending order, so the result is sorted and free of duplicates
+    std::vector<year_month_day> holidays;
+    holidays.reserve(bitmap.count());
+    bitmap.forEach([&](unsigned index) { holidays.push_back(YearBitmap::dateAt(year, index)); });
 
     return holidays;
 } // LCOV_EXCL_LINE
 
 std::vector<std::string> HolidayCalendar::getHolidayNames(const year_month_day& date) const {
     std::vector<std::string> names;
+    if (!isHoliday(date)) {
+        return names;
+    }
+
+    // Only dates that are known holidays pay for a scan of the rules
     auto year = static_cast<int>(date.year());
 
-    for (const auto& rule : rules_) {
-        if (rule->appliesTo(year) && rule->calculateDate(year) == date) {
-            names.push_back(rule->getName());
+    const auto& rules = state_->rules;
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+        bool matches = false;
+        forEachRuleDate(rules[i], year, [&](const year_month_day& rule_date) {
+            matches = matches || rule_date == date;
+        });
+        if (matches) {
+            names.emplace_back(holidayName(state_->rule_name_ids[i]));
         }
     }
 
+    {
+        std::scoped_lock lock(state_->mutex);
+        sortExplicitHolidays();
+    }
+    sys_days day{date};
+    for (const auto& holiday : explicitHolidaysIn(day, day + std::chrono::days{1})) {
+        names.emplace_back(holidayName(holiday.name_id));
+    }
+
     return names;
 } // LCOV_EXCL_LINE
 
+void HolidayCalendar::visitHolidays(const year_month_day& from, const year_month_day& to,
+                                    void (*visit)(const void* context, const Holiday& holiday),
+                                    const void* context) const {
+    if (!from.ok() || !to.ok()) {
+        throw std::invalid_argument("Invalid date");
+    }
+    sys_days first{from};
+    sys_days last{to};
+    if (first >= last) {
+        return;
+    }
+
+    {
+        std::scoped_lock lock(state_->mutex);
+        sortExplicitHolidays();
+    }
+
+    const auto& rules = state_->rules;
+    std::array<std::byte, STACK_RULE_DATES * sizeof(RuleDate)> stack_buffer;
+    std::pmr::monotonic_buffer_resource buffer(stack_buffer.data(), stack_buffer.size());
+    std::pmr::vector<RuleDate> rule_dates(&buffer);
+    rule_dates.reserve(rules.size());
+
+    const int last_year = static_cast<int>(year_month_day{last - std::chrono::days{1}}.year());
+    for (int year = static_cast<int>(from.year()); year <= last_year; ++year) {
+        const auto year_first = std::max(first, startOf(year));
+        const auto year_last = std::min(last, startOf(year + 1));
+
+        rule_dates.clear();
+        for (std::size_t i = 0; i < rules.size(); ++i) {
+            forEachRuleDate(rules[i], year, [&](const year_month_day& date) {
+                sys_days day{date};
+                if (day >= year_first && day < year_last) {
+                    rule_dates.push_back({day, static_cast<std::uint32_t>(i)});
+                }
+            });
+        }
+        // Sorting by rule too keeps each day's rules in the order they were added, without the
+        // temporary buffer of a stable sort; a rule placing the same day twice (from adjacent
+        // years) names it once, as in getHolidayNames()
+        std::ranges::sort(rule_dates);
+        auto unique_end = std::ranges::unique(rule_dates).begin();
+
+        auto rule_date = rule_dates.begin();
+        auto explicit_holidays = explicitHolidaysIn(year_first, year_last);
+        auto explicit_holiday = explicit_holidays.begin();
+        while (rule_date != unique_end || explicit_holiday != explicit_holidays.end()) {
+            auto day = rule_date == unique_end ? explicit_holiday->day
+                       : explicit_holiday == explicit_holidays.end()
+                           ? rule_date->day
+                           : std::min(rule_date->day, explicit_holiday->day);
+            const year_month_day date{day};
+            for (; rule_date != unique_end && rule_date->day == day; ++rule_date) {
+                auto name_id = state_->rule_name_ids[rule_date->rule];
+                visit(context, Holiday{date, holidayName(name_id), name_id});
+            }
+            for (; explicit_holiday != explicit_holidays.end() && explicit_holiday->day == day;
+                 ++explicit_holiday) {
+                visit(context, Holiday{date, holidayName(explicit_holiday->name_id),
+                                       explicit_holiday->name_id});
+            }
+        }
+    }
+}
+
+const YearBitmap& HolidayCalendar::getHolidayBitmap(int year) const {
+    // Keeps the shared empty state free of cached years
+    if (state_->rules.empty() && state_->explicit_holidays.empty()) {
+        static constexpr YearBitmap NO_HOLIDAYS;
+        return NO_HOLIDAYS;
+    }
+
+    return state_->years.get(year, [this, year] {
+        {
+            std::scoped_lock lock(state_->mutex);
+            sortExplicitHolidays();
+        }
+        return buildBitmap(year);
+    });
+}
+
+YearBitmap HolidayCalendar::getBusinessDayBitmap(int year, WeekendMask weekend) const {
+    return YearBitmap::allDays(year) & ~(getHolidayBitmap(year) | weekend.daysIn(year));
+}
+
+YearBitmap HolidayCalendar::buildBitmap(int year) const {
+    detail::recordYearBitmapBuilt();
+    YearBitmap bitmap;
+
+    // Observed holidays spilling over from the adjacent years are resolved here, once per year
+    for (const auto& rule : state_->rules) {
+        forEachRuleDate(rule, year,
+                        [&](const year_month_day& date) { bitmap.set(YearBitmap::indexOf(date)); });
+    }
+
+    auto first = startOf(year);
+    for (const auto& holiday : explicitHolidaysIn(first, startOf(year + 1))) {
+        bitmap.set(static_cast<unsigned>((holiday.day - first).count()));
+    }
+
+    return bitmap;
+}
+
+void HolidayCalendar::sortExplicitHolidays() const {
+    if (!state_->explicit_sorted) {
+        std::ranges::stable_sort(state_->explicit_holidays, {}, &ExplicitHoliday::day);
+        state_->explicit_sorted = true;
+    }
+}
+
+std::span<const HolidayCalendar::ExplicitHoliday>
+HolidayCalendar::explicitHolidaysIn(sys_days from, sys_days to) const {
+    const auto& holidays = state_->explicit_holidays;
+    auto first = std::ranges::lower_bound(holidays, from, {}, &ExplicitHoliday::day);
+    auto last = std::ranges::lower_bound(first, holidays.end(), to, {}, &ExplicitHoliday::day);
+    return {first, last};
+}
+
+CompiledCalendar HolidayCalendar::freeze(int from_year, int to_year) const {
+    if (to_year < from_year) {
+        throw std::invalid_argument("Last year must not be before first year");
+    }
+
+    const auto& rules = state_->rules;
+    std::vector<std::pair<sys_days, std::uint32_t>> entries;
+    for (int year = from_year; year <= to_year; ++year) {
+        for (std::size_t i = 0; i < rules.size(); ++i) {
+            // Same dates as buildBitmap(), so the snapshot agrees with isHoliday()
+            forEachRuleDate(rules[i], year, [&](const year_month_day& date) {
+                entries.emplace_back(sys_days{date}, state_->rule_name_ids[i]);
+            });
+        }
+    }
+
+    {
+        std::scoped_lock lock(state_->mutex);
+        sortExplicitHolidays();
+    }
+    for (const auto& holiday : explicitHolidaysIn(startOf(from_year), startOf(to_year + 1))) {
+        entries.emplace_back(holiday.day, holiday.name_id);
+    }
+
+    return CompiledCalendar(from_year, to_year, std::move(entries));
+}
+
+HolidayCalendar::StoredRule HolidayCalendar::storeRule(std::unique_ptr<HolidayRule> rule) {
+    if (!rule) {
+        throw std::invalid_argument("Rule must not be null");
+    }
+
+    // Only exact types are stored by value: a derived class may override any member
+    const auto& type = typeid(*rule);
+    if (type == typeid(FixedDateRule)) {
+        return std::move(static_cast<FixedDateRule&>(*rule));
+    }
+    if (type == typeid(NthWeekdayRule)) {
+        return std::move(static_cast<NthWeekdayRule&>(*rule));
+    }
+    if (type == typeid(ExplicitDateRule)) {
+        return std::move(static_cast<ExplicitDateRule&>(*rule));
+    }
+    if (type == typeid(EasterOffsetRule)) {
+        return std::move(static_cast<EasterOffsetRule&>(*rule));
+    }
+    return std::shared_ptr<const HolidayRule>(std::move(rule));
+}
+
+const std::shared_ptr<HolidayCalendar::State>& HolidayCalendar::emptyState() noexcept {
+    // Never modified: this reference keeps it shared, so mutableState() always detaches from it,
+    // and getHolidayBitmap() does not cache years of a calendar without holidays
+    static const auto empty = std::make_shared<State>();
+    return empty;
+}
+
+HolidayCalendar::State& HolidayCalendar::mutableState() {
+    // The count is only stable because callers exclude copying and destroying every calendar
+    // sharing the state while this one is modified (see the class documentation)
+    if (state_.use_count() == 1) {
+        // Sole owner: no other calendar can observe the change, so update in place
+        state_->years.clear();
+    } else {
+        auto detached = std::make_shared<State>();
+        detached->rules = state_->rules;
+        detached->rule_name_ids = state_->rule_name_ids;
+        {
+            // Another copy may be sorting the shared array
+            std::scoped_lock lock(state_->mutex);
+            detached->explicit_holidays = state_->explicit_holidays;
+            detached->explicit_sorted = state_->explicit_sorted;
+        }
+        state_ = std::move(detached);
+    }
+    return *state_;
+}
+
 } // namespace datelib
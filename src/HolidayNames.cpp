@@ -0,0 +1,81 @@
+#include "datelib/HolidayNames.h"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace datelib {
+
+namespace {
+// Names are published in blocks, so that a lookup by ID never sees storage being reallocated
+constexpr std::size_t BLOCK_SIZE = 1024;
+
+constexpr std::size_t MAX_BLOCKS = 4096;
+
+/**
+ * @brief Append-only table of names
+ *
+ * Writers hold the mutex. Readers take no lock: a block is fully allocated before its pointer is
+ * published, and a slot is written before the count covering it is released, so any ID a reader
+ * can hold refers to a name already in place.
+ */
+struct NameTable {
+    std::mutex mutex;
+
+    // Owns the characters; a deque never moves its elements, so views of them stay valid
+    std::deque<std::string> storage;
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+    std::array<std::unique_ptr<std::string_view[]>, MAX_BLOCKS> owned_blocks;
+
+    std::array<std::atomic<const std::string_view*>, MAX_BLOCKS> blocks{};
+    std::atomic<std::uint32_t> count{0};
+};
+
+NameTable& table() {
+    static NameTable names;
+    return names;
+}
+} // namespace
+
+std::uint32_t internHolidayName(std::string_view name) {
+    auto& names = table();
+    std::scoped_lock lock(names.mutex);
+    if (auto it = names.ids.find(name); it != names.ids.end()) {
+        return it->second;
+    }
+
+    auto id = names.count.load(std::memory_order_relaxed);
+    auto block = id / BLOCK_SIZE;
+    if (block >= MAX_BLOCKS) {
+        throw std::length_error("Too many distinct holiday names");
+    }
+    if (!names.owned_blocks[block]) {
+        names.owned_blocks[block] = std::make_unique<std::string_view[]>(BLOCK_SIZE);
+        names.blocks[block].store(names.owned_blocks[block].get(), std::memory_order_release);
+    }
+
+    const auto& stored = names.storage.emplace_back(name);
+    names.owned_blocks[block][id % BLOCK_SIZE] = stored;
+    names.ids.emplace(stored, id);
+    names.count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+std::string_view holidayName(std::uint32_t id) {
+    auto& names = table();
+    if (id >= names.count.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown holiday name ID");
+    }
+    return names.blocks[id / BLOCK_SIZE].load(std::memory_order_acquire)[id % BLOCK_SIZE];
+}
+
+std::size_t holidayNameCount() noexcept {
+    return table().count.load(std::memory_order_acquire);
+}
+
+} // namespace datelib
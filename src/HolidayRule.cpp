@@ -3,167 +3,217 @@
 #include "datelib/exceptions.h"
 
 #include <stdexcept>
+#include <typeinfo>
 #include <utility>
 
 namespace datelib {
 
-using std::chrono::day;
-using std::chrono::days;
-using std::chrono::month;
-using std::chrono::month_day_last;
-using std::chrono::sys_days;
-using std::chrono::weekday;
-using std::chrono::year;
 using std::chrono::year_month_day;
-using std::chrono::year_month_day_last;
 
 namespace {
-// Month and day validation constants
-constexpr unsigned MIN_MONTH = 1;
-constexpr unsigned MAX_MONTH = 12;
-constexpr unsigned MIN_DAY = 1;
-constexpr unsigned MAX_DAY = 31;
-constexpr unsigned MAX_WEEKDAY = 6;
-constexpr int DAYS_PER_WEEK = 7;
+/**
+ * @brief Check that a rule is exactly of its static type, not of a class derived from it
+ *
+ * The built-in rules answer tryCalculate() and getNameId() from their stored date and name ID,
+ * without virtual calls. A derived class may redefine the date through appliesTo() or
+ * calculateDate(), or rename the holiday through getName(), so for any other dynamic type these
+ * fall back to the HolidayRule defaults, which go through the virtual functions.
+ */
+template <typename Rule>
+bool isExactly(const Rule& rule) noexcept {
+    return typeid(rule) == typeid(Rule);
+}
 } // namespace
 
-// ExplicitDateRule implementation
-ExplicitDateRule::ExplicitDateRule(std::string name, year_month_day date)
-    : name_(std::move(name)), date_(date) {
-    if (!date_.ok()) {
-        throw std::invalid_argument("Invalid date");
+std::optional<year_month_day> HolidayRule::tryCalculate(int year) const noexcept {
+    try {
+        if (!appliesTo(year)) {
+            return std::nullopt;
+        }
+        return calculateDate(year);
+    } catch (...) {
+        return std::nullopt;
     }
 }
 
+std::uint32_t HolidayRule::getNameId() const {
+    return internHolidayName(getName());
+}
+
+// ExplicitDateRule implementation
+ExplicitDateRule::ExplicitDateRule(std::string name, year_month_day date)
+    : name_id_(internHolidayName(name)), date_(date) {}
+
 bool ExplicitDateRule::appliesTo(int year) const {
-    return static_cast<int>(date_.year()) == year;
+    return date_.tryCalculate(year).has_value();
 }
 
 year_month_day ExplicitDateRule::calculateDate(int year) const {
-    // Only return the date if it matches the requested year
-    if (static_cast<int>(date_.year()) == year) {
-        return date_;
+    if (auto date = date_.tryCalculate(year)) {
+        return *date;
     }
     throw DateNotInYearException("Explicit date does not exist in this year");
 }
 
+std::optional<year_month_day> ExplicitDateRule::tryCalculate(int year) const noexcept {
+    if (!isExactly(*this)) {
+        return HolidayRule::tryCalculate(year);
+    }
+    return date_.tryCalculate(year);
+}
+
+std::uint32_t ExplicitDateRule::getNameId() const {
+    if (!isExactly(*this)) {
+        return HolidayRule::getNameId();
+    }
+    return name_id_;
+}
+
 std::unique_ptr<HolidayRule> ExplicitDateRule::clone() const {
-    return std::make_unique<ExplicitDateRule>(name_, date_);
+    return std::make_unique<ExplicitDateRule>(*this);
 }
 
 // FixedDateRule implementation
 FixedDateRule::FixedDateRule(std::string name, unsigned month, unsigned day)
-    : name_(std::move(name)), month_{month}, day_{day} {
-    if (month < MIN_MONTH || month > MAX_MONTH) {
-        throw std::invalid_argument("Month must be between 1 and 12");
-    }
-    if (day < MIN_DAY || day > MAX_DAY) {
-        throw std::invalid_argument("Day must be between 1 and 31");
-    }
-}
+    : name_id_(internHolidayName(name)), date_(month, day) {}
 
 bool FixedDateRule::appliesTo(int year) const {
-    year_month_day ymd{std::chrono::year{year}, month_, day_};
-    return ymd.ok();
+    return date_.tryCalculate(year).has_value();
 }
 
 year_month_day FixedDateRule::calculateDate(int year) const {
-    year_month_day ymd{std::chrono::year{year}, month_, day_};
-    if (!ymd.ok()) {
-        throw InvalidDateException("Invalid date for this year");
+    if (auto date = date_.tryCalculate(year)) {
+        return *date;
     }
-    return ymd;
+    throw InvalidDateException("Invalid date for this year");
+}
+
+std::optional<year_month_day> FixedDateRule::tryCalculate(int year) const noexcept {
+    if (!isExactly(*this)) {
+        return HolidayRule::tryCalculate(year);
+    }
+    return date_.tryCalculate(year);
+}
+
+std::uint32_t FixedDateRule::getNameId() const {
+    if (!isExactly(*this)) {
+        return HolidayRule::getNameId();
+    }
+    return name_id_;
 }
 
 std::unique_ptr<HolidayRule> FixedDateRule::clone() const {
-    return std::make_unique<FixedDateRule>(name_, static_cast<unsigned>(month_),
-                                           static_cast<unsigned>(day_));
+    return std::make_unique<FixedDateRule>(*this);
 }
 
 // NthWeekdayRule implementation
 NthWeekdayRule::NthWeekdayRule(std::string name, unsigned month, unsigned weekday_val,
                                Occurrence occurrence)
-    : name_(std::move(name)), month_{month}, weekday_{weekday_val}, occurrence_(occurrence) {
-    if (month < MIN_MONTH || month > MAX_MONTH) {
-        throw std::invalid_argument("Month must be between 1 and 12");
-    }
-    if (weekday_val > MAX_WEEKDAY) {
-        throw std::invalid_argument("Weekday must be between 0 and 6");
+    : name_id_(internHolidayName(name)), date_(month, weekday_val, occurrence) {}
+
+bool NthWeekdayRule::appliesTo(int year) const {
+    return date_.tryCalculate(year).has_value();
+}
+
+year_month_day NthWeekdayRule::calculateDate(int year) const {
+    if (auto date = date_.tryCalculate(year)) {
+        return *date;
     }
-    int occ_val = std::to_underlying(occurrence);
-    if (occ_val == 0 || occ_val < -1 || occ_val > 5) {
-        throw std::invalid_argument("Occurrence must be First through Fifth or Last");
+    throw OccurrenceNotFoundException("Requested occurrence does not exist in this month");
+}
+
+std::optional<year_month_day> NthWeekdayRule::tryCalculate(int year) const noexcept {
+    if (!isExactly(*this)) {
+        return HolidayRule::tryCalculate(year);
     }
+    return date_.tryCalculate(year);
 }
 
-bool NthWeekdayRule::appliesTo(int year) const {
-    // For Last occurrence, it always applies
-    int occ_val = std::to_underlying(occurrence_);
-    if (occ_val < 0) {
-        return true;
+std::uint32_t NthWeekdayRule::getNameId() const {
+    if (!isExactly(*this)) {
+        return HolidayRule::getNameId();
     }
+    return name_id_;
+}
 
-    // For Nth occurrence, check if it exists in the month
-    year_month_day first_of_month{std::chrono::year{year}, month_, day{1}};
-    sys_days first_sd{first_of_month};
-    weekday first_weekday{first_sd};
+std::unique_ptr<HolidayRule> NthWeekdayRule::clone() const {
+    return std::make_unique<NthWeekdayRule>(*this);
+}
 
-    int days_until_target =
-        (weekday_.c_encoding() - first_weekday.c_encoding() + DAYS_PER_WEEK) % DAYS_PER_WEEK;
-    sys_days target_sd = first_sd + days{days_until_target + (occ_val - 1) * DAYS_PER_WEEK};
-    year_month_day result{target_sd};
+// EasterOffsetRule implementation
+EasterOffsetRule::EasterOffsetRule(std::string name, int offset_days, EasterType type)
+    : name_id_(internHolidayName(name)), date_(offset_days, type) {}
 
-    return result.month() == month_;
+bool EasterOffsetRule::appliesTo(int year) const {
+    return date_.tryCalculate(year).has_value();
 }
 
-year_month_day NthWeekdayRule::calculateDate(int year) const {
-    // Get the first day of the month
-    year_month_day first_of_month{std::chrono::year{year}, month_, day{1}};
-
-    // Convert to sys_days to work with weekdays
-    sys_days first_sd{first_of_month};
-    weekday first_weekday{first_sd};
-
-    int occ_val = std::to_underlying(occurrence_);
-    if (occ_val > 0) {
-        // Find the Nth occurrence of the target weekday
-        // Calculate days to add to reach first occurrence of target weekday
-        int days_until_target =
-            (weekday_.c_encoding() - first_weekday.c_encoding() + DAYS_PER_WEEK) % DAYS_PER_WEEK;
-
-        // Add weeks to get to the Nth occurrence
-        sys_days target_sd = first_sd + days{days_until_target + (occ_val - 1) * DAYS_PER_WEEK};
-        year_month_day result{target_sd};
-
-        // Verify we're still in the same month
-        if (result.month() != month_) {
-            throw OccurrenceNotFoundException("Requested occurrence does not exist in this month");
-        }
+year_month_day EasterOffsetRule::calculateDate(int year) const {
+    if (auto date = date_.tryCalculate(year)) {
+        return *date;
+    }
+    throw DateNotInYearException("Easter-relative date is not available in this year");
+}
 
-        return result;
-    } else {
-        // Last occurrence
-        // Get the last day of the month
-        year_month_day_last last_of_month{std::chrono::year{year}, month_day_last{month_}};
-        year_month_day last_day{last_of_month};
+std::optional<year_month_day> EasterOffsetRule::tryCalculate(int year) const noexcept {
+    if (!isExactly(*this)) {
+        return HolidayRule::tryCalculate(year);
+    }
+    return date_.tryCalculate(year);
+}
 
-        sys_days last_sd{last_day};
-        weekday last_weekday{last_sd};
+std::uint32_t EasterOffsetRule::getNameId() const {
+    if (!isExactly(*this)) {
+        return HolidayRule::getNameId();
+    }
+    return name_id_;
+}
 
-        // Calculate days to subtract to get to last occurrence of target weekday
-        int days_to_subtract =
-            (last_weekday.c_encoding() - weekday_.c_encoding() + DAYS_PER_WEEK) % DAYS_PER_WEEK;
+std::unique_ptr<HolidayRule> EasterOffsetRule::clone() const {
+    return std::make_unique<EasterOffsetRule>(*this);
+}
 
-        sys_days target_sd = last_sd - days{days_to_subtract};
-        year_month_day result{target_sd};
+// ObservedRule implementation
+ObservedRule::ObservedRule(std::unique_ptr<HolidayRule> rule, Observance observance)
+    : observance_(observance) {
+    if (!rule) {
+        throw std::invalid_argument("Rule must not be null");
+    }
+    rule_ = std::move(rule);
+}
 
-        return result;
+bool ObservedRule::appliesTo(int year) const {
+    return rule_->appliesTo(year);
+}
+
+year_month_day ObservedRule::calculateDate(int year) const {
+    auto date = rule_->calculateDate(year);
+    if (!date.ok()) {
+        throw InvalidDateException("Invalid date for this year");
     }
+    return observance_.apply(date);
 }
 
-std::unique_ptr<HolidayRule> NthWeekdayRule::clone() const {
-    return std::make_unique<NthWeekdayRule>(name_, static_cast<unsigned>(month_),
-                                            weekday_.c_encoding(), occurrence_);
+std::optional<year_month_day> ObservedRule::tryCalculate(int year) const noexcept {
+    if (!isExactly(*this)) {
+        return HolidayRule::tryCalculate(year);
+    }
+    auto date = rule_->tryCalculate(year);
+    if (!date || !date->ok()) {
+        return std::nullopt;
+    }
+    return observance_.apply(*date);
+}
+
+std::uint32_t ObservedRule::getNameId() const {
+    if (!isExactly(*this)) {
+        return HolidayRule::getNameId();
+    }
+    return rule_->getNameId();
+}
+
+std::unique_ptr<HolidayRule> ObservedRule::clone() const {
+    return std::make_unique<ObservedRule>(*this);
 }
 
 } // namespace datelib
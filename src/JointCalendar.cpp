@@ -0,0 +1,58 @@
+#include "datelib/JointCalendar.h"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace datelib {
+
+using std::chrono::year_month_day;
+
+void JointCalendar::add(const HolidayCalendar& calendar, WeekendMask weekend) {
+    // A new cache rather than a cleared one: copies of this calendar may share the old one
+    auto years = std::make_shared<const detail::YearCache>();
+    members_.push_back({calendar, weekend});
+    years_ = std::move(years);
+}
+
+bool JointCalendar::isBusinessDay(const year_month_day& date) const {
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to isBusinessDay");
+    }
+    if (!years_) {
+        return true;
+    }
+    auto year = static_cast<int>(date.year());
+    return years_->get(year, [this, year] { return combine(year); })
+        .test(YearBitmap::indexOf(date));
+}
+
+YearBitmap JointCalendar::getBusinessDayBitmap(int year) const {
+    if (!years_) {
+        return YearBitmap::allDays(year);
+    }
+    return years_->get(year, [this, year] { return combine(year); });
+}
+
+YearBitmap JointCalendar::combine(int year) const {
+    auto all_days = YearBitmap::allDays(year);
+
+    // Days that are not business days in a calendar: its holidays and its weekend
+    auto closed = [year](const Member& member) {
+        return member.calendar.getHolidayBitmap(year) | member.weekend.daysIn(year);
+    };
+
+    auto combined = closed(members_.front());
+    for (std::size_t i = 1; i < members_.size(); ++i) {
+        if (rule_ == JoinRule::JoinHolidays) {
+            // Closed in any calendar
+            combined |= closed(members_[i]);
+        } else {
+            // Closed in every calendar
+            combined &= closed(members_[i]);
+        }
+    }
+    return all_days & ~combined;
+}
+
+} // namespace datelib
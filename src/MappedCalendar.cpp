@@ -0,0 +1,461 @@
+#include "datelib/MappedCalendar.h"
+
+#include "datelib/CompiledCalendar.h"
+#include "datelib/detail/stats.h"
+#include "datelib/exceptions.h"
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace datelib {
+
+using std::chrono::sys_days;
+using std::chrono::year_month_day;
+
+namespace {
+constexpr std::string_view MAGIC = "DATELIBC";
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 48;
+constexpr std::size_t SECTION_ALIGNMENT = 8;
+
+// Header field positions
+constexpr std::size_t VERSION_OFFSET = 8;
+constexpr std::size_t FIRST_YEAR_OFFSET = 12;
+constexpr std::size_t LAST_YEAR_OFFSET = 16;
+constexpr std::size_t HOLIDAY_COUNT_OFFSET = 20;
+constexpr std::size_t NAME_REF_COUNT_OFFSET = 24;
+constexpr std::size_t NAME_COUNT_OFFSET = 28;
+constexpr std::size_t NAME_BYTES_OFFSET = 32;
+constexpr std::size_t FILE_SIZE_OFFSET = 40;
+
+// Years representable by std::chrono::year
+constexpr int MIN_YEAR = -32767;
+constexpr int MAX_YEAR = 32767;
+
+constexpr std::size_t BITMAP_BYTES = YearBitmap::WORDS * sizeof(std::uint64_t);
+
+/**
+ * @brief Position of each section in a file with the given counts
+ */
+struct Layout {
+    std::uint64_t bitmaps;
+    std::uint64_t holidays;
+    std::uint64_t name_offsets;
+    std::uint64_t name_refs;
+    std::uint64_t name_table;
+    std::uint64_t name_chars;
+    std::uint64_t end;
+};
+
+constexpr std::uint64_t alignSection(std::uint64_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) & ~std::uint64_t{SECTION_ALIGNMENT - 1};
+}
+
+constexpr Layout layoutOf(std::uint64_t years, std::uint64_t holiday_count,
+                          std::uint64_t name_ref_count, std::uint64_t name_count,
+                          std::uint64_t name_bytes) {
+    Layout layout{};
+    layout.bitmaps = HEADER_SIZE;
+    layout.holidays = alignSection(layout.bitmaps + years * BITMAP_BYTES);
+    layout.name_offsets = alignSection(layout.holidays + holiday_count * 4);
+    layout.name_refs = alignSection(layout.name_offsets + (holiday_count + 1) * 4);
+    layout.name_table = alignSection(layout.name_refs + name_ref_count * 4);
+    layout.name_chars = alignSection(layout.name_table + (name_count + 1) * 4);
+    layout.end = alignSection(layout.name_chars + name_bytes);
+    return layout;
+}
+
+/**
+ * @brief Read a little-endian integer from a possibly unaligned position
+ */
+template <typename T>
+T load(const std::byte* position) noexcept {
+    T value;
+    std::memcpy(&value, position, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+/**
+ * @brief Read element i of a section of integers
+ */
+template <typename T>
+T loadAt(const std::byte* section, std::size_t i) noexcept {
+    return load<T>(section + i * sizeof(T));
+}
+
+/**
+ * @brief Append an integer to a buffer in little-endian byte order
+ */
+template <typename T>
+void store(std::string& buffer, T value) {
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Pad a buffer with zeros up to a section boundary
+ */
+void padSection(std::string& buffer) {
+    buffer.resize(alignSection(buffer.size()), '\0');
+}
+
+/**
+ * @brief Write a whole buffer to a file descriptor
+ * @return false on any error other than an interrupted call
+ */
+bool writeAll(int fd, std::string_view data) noexcept {
+    while (!data.empty()) {
+        auto written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+/**
+ * @brief Flush a directory, so that a rename into it survives a crash
+ */
+bool syncDirectory(const std::filesystem::path& directory) noexcept {
+    const char* name = directory.empty() ? "." : directory.c_str();
+    int fd = ::open(name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+} // namespace
+
+void writeCalendarFile(const CompiledCalendar& calendar, const std::filesystem::path& path) {
+    auto holidays = calendar.holidays();
+
+    // Intern the names, keeping the order in which each holiday lists them
+    std::unordered_map<std::string, std::uint32_t> name_lookup;
+    std::vector<std::string> names;
+    std::vector<std::uint32_t> name_offsets;
+    std::vector<std::uint32_t> name_refs;
+    name_offsets.reserve(holidays.size() + 1);
+    for (auto day : holidays) {
+        name_offsets.push_back(static_cast<std::uint32_t>(name_refs.size()));
+        for (auto& name : calendar.getHolidayNames(year_month_day{day})) {
+            auto [it, inserted] =
+                name_lookup.try_emplace(name, static_cast<std::uint32_t>(names.size()));
+            if (inserted) {
+                names.push_back(std::move(name));
+            }
+            name_refs.push_back(it->second);
+        }
+    }
+    name_offsets.push_back(static_cast<std::uint32_t>(name_refs.size()));
+
+    std::size_t name_bytes = 0;
+    for (const auto& name : names) {
+        name_bytes += name.size();
+    }
+
+    auto years = static_cast<std::uint64_t>(calendar.lastYear() - calendar.firstYear()) + 1;
+    auto layout = layoutOf(years, holidays.size(), name_refs.size(), names.size(), name_bytes);
+
+    std::string buffer;
+    buffer.reserve(layout.end);
+    buffer.append(MAGIC);
+    store(buffer, VERSION);
+    store(buffer, static_cast<std::int32_t>(calendar.firstYear()));
+    store(buffer, static_cast<std::int32_t>(calendar.lastYear()));
+    store(buffer, static_cast<std::uint32_t>(holidays.size()));
+    store(buffer, static_cast<std::uint32_t>(name_refs.size()));
+    store(buffer, static_cast<std::uint32_t>(names.size()));
+    store(buffer, static_cast<std::uint32_t>(name_bytes));
+    store(buffer, std::uint32_t{0});
+    store(buffer, layout.end);
+
+    for (int year = calendar.firstYear(); year <= calendar.lastYear(); ++year) {
+        for (auto word : calendar.getHolidayBitmap(year).words()) {
+            store(buffer, word);
+        }
+    }
+    padSection(buffer);
+
+    for (auto day : holidays) {
+        store(buffer, static_cast<std::int32_t>(day.time_since_epoch().count()));
+    }
+    padSection(buffer);
+
+    for (auto offset : name_offsets) {
+        store(buffer, offset);
+    }
+    padSection(buffer);
+
+    for (auto ref : name_refs) {
+        store(buffer, ref);
+    }
+    padSection(buffer);
+
+    std::uint32_t name_offset = 0;
+    store(buffer, name_offset);
+    for (const auto& name : names) {
+        name_offset += static_cast<std::uint32_t>(name.size());
+        store(buffer, name_offset);
+    }
+    padSection(buffer);
+
+    for (const auto& name : names) {
+        buffer.append(name);
+    }
+    padSection(buffer);
+
+    // Write to a uniquely named file beside the destination, flush it to disk and rename it, so
+    // that readers never see a partial file, concurrent writers never share a temporary file, and
+    // after a crash the destination holds either the previous or the new calendar
+    auto temporary = path;
+    temporary += ".XXXXXX";
+    std::string name = temporary.string();
+    int fd = ::mkstemp(name.data());
+    if (fd < 0) {
+        throw CalendarFileException("Unable to write calendar file " + path.string());
+    }
+    temporary = name;
+    // mkstemp() creates the file readable by its owner only; calendar files are shared. The
+    // umask is not applied, as reading it means setting it, which races with other threads
+    bool written = writeAll(fd, buffer) && ::fchmod(fd, 0644) == 0 && ::fsync(fd) == 0;
+    written = ::close(fd) == 0 && written;
+
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(temporary, path, error);
+    }
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+        throw CalendarFileException("Unable to write calendar file " + path.string());
+    }
+    if (!syncDirectory(path.parent_path())) {
+        throw CalendarFileException("Replaced calendar file " + path.string() +
+                                    " but could not sync its directory");
+    }
+}
+
+MappedCalendar::MappedCalendar(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw CalendarFileException("Unable to open calendar file " + path.string());
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(HEADER_SIZE)) {
+        ::close(fd);
+        throw CalendarFileException("Not a calendar file: " + path.string());
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw CalendarFileException("Unable to map calendar file " + path.string());
+    }
+    data_ = static_cast<const std::byte*>(mapping);
+
+    // Only the header and the section sizes are checked, so opening does not depend on the size
+    // of the calendar
+    if (std::memcmp(data_, MAGIC.data(), MAGIC.size()) != 0) {
+        unmap();
+        throw CalendarFileException("Not a calendar file: " + path.string());
+    }
+    if (auto version = load<std::uint32_t>(data_ + VERSION_OFFSET); version != VERSION) {
+        unmap();
+        throw CalendarFileException("Unsupported calendar file version " +
+                                    std::to_string(version) + ": " + path.string());
+    }
+
+    first_year_ = load<std::int32_t>(data_ + FIRST_YEAR_OFFSET);
+    last_year_ = load<std::int32_t>(data_ + LAST_YEAR_OFFSET);
+    holiday_count_ = load<std::uint32_t>(data_ + HOLIDAY_COUNT_OFFSET);
+    name_ref_count_ = load<std::uint32_t>(data_ + NAME_REF_COUNT_OFFSET);
+    name_count_ = load<std::uint32_t>(data_ + NAME_COUNT_OFFSET);
+    name_bytes_ = load<std::uint32_t>(data_ + NAME_BYTES_OFFSET);
+    if (first_year_ < MIN_YEAR || last_year_ > MAX_YEAR || first_year_ > last_year_) {
+        unmap();
+        throw CalendarFileException("Invalid year range in calendar file " + path.string());
+    }
+
+    auto layout = layoutOf(static_cast<std::uint64_t>(last_year_ - first_year_) + 1,
+                           holiday_count_, name_ref_count_, name_count_, name_bytes_);
+    if (load<std::uint64_t>(data_ + FILE_SIZE_OFFSET) != size_ || layout.end != size_) {
+        unmap();
+        throw CalendarFileException("Calendar file has the wrong size: " + path.string());
+    }
+
+    bitmaps_ = data_ + layout.bitmaps;
+    holidays_ = data_ + layout.holidays;
+    name_offsets_ = data_ + layout.name_offsets;
+    name_refs_ = data_ + layout.name_refs;
+    name_table_ = data_ + layout.name_table;
+    name_chars_ = data_ + layout.name_chars;
+}
+
+MappedCalendar::MappedCalendar(MappedCalendar&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedCalendar& MappedCalendar::operator=(MappedCalendar&& other) noexcept {
+    // The moved-from calendar takes over this mapping and releases it when destroyed
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(first_year_, other.first_year_);
+    std::swap(last_year_, other.last_year_);
+    std::swap(holiday_count_, other.holiday_count_);
+    std::swap(name_ref_count_, other.name_ref_count_);
+    std::swap(name_count_, other.name_count_);
+    std::swap(name_bytes_, other.name_bytes_);
+    std::swap(bitmaps_, other.bitmaps_);
+    std::swap(holidays_, other.holidays_);
+    std::swap(name_offsets_, other.name_offsets_);
+    std::swap(name_refs_, other.name_refs_);
+    std::swap(name_table_, other.name_table_);
+    std::swap(name_chars_, other.name_chars_);
+    return *this;
+}
+
+MappedCalendar::~MappedCalendar() {
+    unmap();
+}
+
+void MappedCalendar::unmap() noexcept {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+bool MappedCalendar::contains(const year_month_day& date) const noexcept {
+    if (!date.ok()) {
+        return false;
+    }
+    auto year = static_cast<int>(date.year());
+    return year >= first_year_ && year <= last_year_;
+}
+
+bool MappedCalendar::isHoliday(const year_month_day& date) const {
+    detail::LatencyTimer timer(StatsOperation::IsHoliday);
+    if (!date.ok()) {
+        return false;
+    }
+    auto slot = yearSlot(static_cast<int>(date.year()));
+    auto index = YearBitmap::indexOf(date);
+    auto word = loadAt<std::uint64_t>(bitmaps_,
+                                      slot * YearBitmap::WORDS + index / YearBitmap::WORD_BITS);
+    return ((word >> (index % YearBitmap::WORD_BITS)) & 1U) != 0;
+}
+
+std::vector<year_month_day> MappedCalendar::getHolidays(int year) const {
+    detail::LatencyTimer timer(StatsOperation::GetHolidays);
+    auto bitmap = getHolidayBitmap(year);
+
+    std::vector<year_month_day> holidays;
+    holidays.reserve(bitmap.count());
+    bitmap.forEach([&](unsigned index) { holidays.push_back(YearBitmap::dateAt(year, index)); });
+
+    return holidays;
+} // LCOV_EXCL_LINE
+
+std::vector<std::string> MappedCalendar::getHolidayNames(const year_month_day& date) const {
+    std::vector<std::string> names;
+    if (!isHoliday(date)) {
+        return names;
+    }
+
+    auto position = findHoliday(sys_days{date});
+    if (position == holiday_count_) {
+        throw CalendarFileException("Calendar file holiday array does not match its bitmaps");
+    }
+
+    auto first = loadAt<std::uint32_t>(name_offsets_, position);
+    auto last = loadAt<std::uint32_t>(name_offsets_, position + 1);
+    if (first > last || last > name_ref_count_) {
+        throw CalendarFileException("Calendar file has inconsistent name offsets");
+    }
+    for (auto j = first; j < last; ++j) {
+        names.push_back(nameAt(loadAt<std::uint32_t>(name_refs_, j)));
+    }
+
+    return names;
+} // LCOV_EXCL_LINE
+
+YearBitmap MappedCalendar::getHolidayBitmap(int year) const {
+    auto slot = yearSlot(year);
+    std::array<std::uint64_t, YearBitmap::WORDS> words{};
+    for (std::size_t w = 0; w < YearBitmap::WORDS; ++w) {
+        words[w] = loadAt<std::uint64_t>(bitmaps_, slot * YearBitmap::WORDS + w);
+    }
+    return YearBitmap::fromWords(words);
+}
+
+YearBitmap MappedCalendar::getBusinessDayBitmap(int year, WeekendMask weekend) const {
+    return YearBitmap::allDays(year) & ~(getHolidayBitmap(year) | weekend.daysIn(year));
+}
+
+std::size_t MappedCalendar::yearSlot(int year) const {
+    if (year < first_year_ || year > last_year_) {
+        throw YearOutOfRangeException("Year " + std::to_string(year) +
+                                      " is outside the range of the mapped calendar");
+    }
+    return static_cast<std::size_t>(year - first_year_);
+}
+
+std::uint32_t MappedCalendar::findHoliday(sys_days day) const noexcept {
+    auto target = static_cast<std::int32_t>(day.time_since_epoch().count());
+
+    // Lower bound over the mapped array
+    std::uint32_t first = 0;
+    std::uint32_t count = holiday_count_;
+    while (count > 0) {
+        auto step = count / 2;
+        if (loadAt<std::int32_t>(holidays_, first + step) < target) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+
+    if (first < holiday_count_ && loadAt<std::int32_t>(holidays_, first) == target) {
+        return first;
+    }
+    return holiday_count_;
+}
+
+std::string MappedCalendar::nameAt(std::uint32_t id) const {
+    if (id >= name_count_) {
+        throw CalendarFileException("Calendar file has an invalid name reference");
+    }
+    auto first = loadAt<std::uint32_t>(name_table_, id);
+    auto last = loadAt<std::uint32_t>(name_table_, id + 1);
+    if (first > last || last > name_bytes_) {
+        throw CalendarFileException("Calendar file has inconsistent name table offsets");
+    }
+    return {reinterpret_cast<const char*>(name_chars_ + first), last - first};
+}
+
+} // namespace datelib
@@ -0,0 +1,156 @@
+#include "datelib/QueryStats.h"
+
+#include "datelib/detail/stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+namespace datelib {
+
+std::string_view statsOperationName(StatsOperation operation) noexcept {
+    using enum StatsOperation;
+    switch (operation) {
+    case IsHoliday:
+        return "isHoliday";
+    case GetHolidays:
+        return "getHolidays";
+    case IsBusinessDay:
+        return "isBusinessDay";
+    case AdjustFollowing:
+        return "adjust.Following";
+    case AdjustModifiedFollowing:
+        return "adjust.ModifiedFollowing";
+    case AdjustPreceding:
+        return "adjust.Preceding";
+    case AdjustModifiedPreceding:
+        return "adjust.ModifiedPreceding";
+    case AdjustUnadjusted:
+        return "adjust.Unadjusted";
+    }
+    return "unknown";
+}
+
+#ifdef DATELIB_ENABLE_STATS
+namespace {
+/**
+ * @brief Histogram updated concurrently with relaxed atomics
+ *
+ * Aligned to a cache line so that threads recording different operations do not contend.
+ */
+struct alignas(64) AtomicHistogram {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> max{0};
+    std::array<std::atomic<std::uint64_t>, Histogram::BUCKETS> buckets{};
+
+    void record(std::uint64_t value) noexcept {
+        auto bucket = std::min<std::size_t>(std::bit_width(value), Histogram::BUCKETS - 1);
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+
+        auto current = max.load(std::memory_order_relaxed);
+        while (value > current &&
+               !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    Histogram load() const noexcept {
+        Histogram histogram;
+        histogram.count = count.load(std::memory_order_relaxed);
+        histogram.sum = sum.load(std::memory_order_relaxed);
+        histogram.max = max.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < Histogram::BUCKETS; ++i) {
+            histogram.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        return histogram;
+    }
+
+    void reset() noexcept {
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct Counters {
+    std::array<AtomicHistogram, STATS_OPERATION_COUNT> latencies{};
+    AtomicHistogram search_days;
+    alignas(64) std::atomic<std::uint64_t> rule_evaluations{0};
+    std::atomic<std::uint64_t> year_bitmaps_built{0};
+    std::atomic<std::uint64_t> search_limit_exceeded{0};
+};
+
+// Constant-initialized, so the hooks need no guard for a function-local static
+constinit Counters counters;
+} // namespace
+
+namespace detail {
+
+void recordLatency(StatsOperation operation, std::chrono::nanoseconds elapsed) noexcept {
+    auto index = static_cast<std::size_t>(operation);
+    if (index < STATS_OPERATION_COUNT) {
+        counters.latencies[index].record(static_cast<std::uint64_t>(elapsed.count()));
+    }
+}
+
+void recordRuleEvaluations(std::uint64_t count) noexcept {
+    counters.rule_evaluations.fetch_add(count, std::memory_order_relaxed);
+}
+
+void recordYearBitmapBuilt() noexcept {
+    counters.year_bitmaps_built.fetch_add(1, std::memory_order_relaxed);
+}
+
+void recordSearch(std::uint64_t days) noexcept {
+    counters.search_days.record(days);
+}
+
+void recordSearchLimitExceeded() noexcept {
+    counters.search_limit_exceeded.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+bool queryStatsEnabled() noexcept {
+    return true;
+}
+
+QueryStats getQueryStats() noexcept {
+    QueryStats stats;
+    for (std::size_t i = 0; i < STATS_OPERATION_COUNT; ++i) {
+        stats.latencies[i] = counters.latencies[i].load();
+    }
+    stats.rule_evaluations = counters.rule_evaluations.load(std::memory_order_relaxed);
+    stats.year_bitmaps_built = counters.year_bitmaps_built.load(std::memory_order_relaxed);
+    stats.search_days = counters.search_days.load();
+    stats.search_limit_exceeded = counters.search_limit_exceeded.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void resetQueryStats() noexcept {
+    for (auto& latency : counters.latencies) {
+        latency.reset();
+    }
+    counters.rule_evaluations.store(0, std::memory_order_relaxed);
+    counters.year_bitmaps_built.store(0, std::memory_order_relaxed);
+    counters.search_days.reset();
+    counters.search_limit_exceeded.store(0, std::memory_order_relaxed);
+}
+#else
+bool queryStatsEnabled() noexcept {
+    return false;
+}
+
+QueryStats getQueryStats() noexcept {
+    return {};
+}
+
+void resetQueryStats() noexcept {}
+#endif
+
+} // namespace datelib
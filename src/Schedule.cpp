@@ -0,0 +1,254 @@
+#include "datelib/Schedule.h"
+
+#include "datelib/detail/adjust.h"
+#include "datelib/detail/stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace datelib {
+
+using std::chrono::sys_days;
+using std::chrono::year_month_day;
+
+namespace {
+// Number of schedules a thread takes from the shared counter at a time
+constexpr std::size_t CHUNK_SIZE = 64;
+
+constexpr std::size_t WORD_BITS = 64;
+
+/**
+ * @brief Shape of a schedule, derived from its terms alone
+ */
+struct Layout {
+    // Regular dates are rolled backward from the end date rather than forward from the start
+    bool backward;
+
+    // Regular dates are rolled to month ends
+    bool month_end;
+
+    // Number of regular dates strictly between the start and end dates
+    long long regular;
+};
+
+/**
+ * @brief Count the months from the month of one date to the month of another
+ */
+long long monthsBetween(const year_month_day& from, const year_month_day& to) {
+    return (static_cast<long long>(static_cast<int>(to.year())) - static_cast<int>(from.year())) *
+               12 +
+           static_cast<unsigned>(to.month()) - static_cast<unsigned>(from.month());
+}
+
+/**
+ * @brief Move a date by a number of months, keeping its day of month where that month has it
+ * @param to_month_end Whether to land on the last day of the month instead
+ */
+year_month_day roll(const year_month_day& anchor, long long months, bool to_month_end) {
+    auto month =
+        std::chrono::year_month{anchor.year(), anchor.month()} + std::chrono::months{months};
+    std::chrono::year_month_day_last last{month.year(), std::chrono::month_day_last{month.month()}};
+    if (to_month_end || anchor.day() > last.day()) {
+        return year_month_day{last};
+    }
+    return year_month_day{month.year(), month.month(), anchor.day()};
+}
+
+/**
+ * @brief Validate the terms of a schedule and work out its shape
+ */
+Layout layoutOf(const ScheduleSpec& spec) {
+    if (!spec.start.ok() || !spec.end.ok()) {
+        throw std::invalid_argument("Invalid date provided to schedule");
+    }
+    if (sys_days{spec.end} <= sys_days{spec.start}) {
+        throw std::invalid_argument("Schedule end date must be after its start date");
+    }
+    if (spec.tenor.count() <= 0) {
+        throw std::invalid_argument("Schedule tenor must be positive");
+    }
+
+    using enum StubRule;
+    Layout layout{};
+    layout.backward = spec.stub == ShortFront || spec.stub == LongFront;
+    const auto& anchor = layout.backward ? spec.end : spec.start;
+    std::chrono::year_month_day_last anchor_month_end{anchor.year(),
+                                                      std::chrono::month_day_last{anchor.month()}};
+    layout.month_end = spec.end_of_month && anchor.day() == anchor_month_end.day();
+
+    // Regular dates in the months strictly between the start and end months are always inside
+    // the schedule; one landing in the month of the far end date may or may not be
+    const long long tenor = spec.tenor.count();
+    const long long months = monthsBetween(spec.start, spec.end);
+    layout.regular = months > 0 ? (months - 1) / tenor : 0;
+
+    bool stub = true;
+    if (months > 0 && months % tenor == 0) {
+        auto last = roll(anchor, layout.backward ? -months : months, layout.month_end);
+        const auto& far_end = layout.backward ? spec.start : spec.end;
+        stub = last != far_end;
+        if (layout.backward ? sys_days{last} > sys_days{far_end}
+                            : sys_days{last} < sys_days{far_end}) {
+            ++layout.regular;
+        }
+    }
+
+    // A long stub absorbs the regular date next to it
+    if (stub && layout.regular > 0 && (spec.stub == LongFront || spec.stub == LongBack)) {
+        --layout.regular;
+    }
+    return layout;
+}
+} // namespace
+
+ScheduleGenerator::ScheduleGenerator(const HolidayCalendar& calendar, int first_year, int last_year,
+                                     WeekendMask weekend)
+    : calendar_(calendar), weekend_(weekend), first_year_(first_year), last_year_(last_year),
+      first_day_{std::chrono::year{first_year} / std::chrono::January / 1},
+      end_day_{std::chrono::year{last_year + 1} / std::chrono::January / 1} {
+    if (last_year < first_year) {
+        throw std::invalid_argument("Last year must not be before first year");
+    }
+
+    auto length = static_cast<std::size_t>((end_day_ - first_day_).count());
+    business_days_.assign((length + WORD_BITS - 1) / WORD_BITS, 0);
+
+    std::size_t offset = 0;
+    for (int year = first_year; year <= last_year; ++year) {
+        calendar_.getBusinessDayBitmap(year, weekend_).forEach([&](unsigned index) {
+            auto bit = offset + index;
+            business_days_[bit / WORD_BITS] |= std::uint64_t{1} << (bit % WORD_BITS);
+        });
+        offset += YearBitmap::lengthOf(year);
+    }
+}
+
+std::size_t ScheduleGenerator::size(const ScheduleSpec& spec) {
+    return static_cast<std::size_t>(layoutOf(spec).regular) + 2;
+}
+
+std::vector<std::size_t> ScheduleGenerator::offsets(std::span<const ScheduleSpec> specs) {
+    std::vector<std::size_t> result;
+    result.reserve(specs.size() + 1);
+    result.push_back(0);
+    for (const auto& spec : specs) {
+        result.push_back(result.back() + size(spec));
+    }
+    return result;
+}
+
+std::size_t ScheduleGenerator::generate(const ScheduleSpec& spec, std::span<sys_days> unadjusted,
+                                        std::span<sys_days> adjusted) const {
+    auto layout = layoutOf(spec);
+    auto count = static_cast<std::size_t>(layout.regular) + 2;
+    if (unadjusted.size() < count || adjusted.size() < count) {
+        throw std::invalid_argument("Output buffers are too small for the schedule");
+    }
+
+    // Regular dates are rolled from the anchor, not from each other, so that a clamped day of
+    // month does not carry over into later periods
+    const long long tenor = spec.tenor.count();
+    unadjusted[0] = sys_days{spec.start};
+    for (long long i = 1; i <= layout.regular; ++i) {
+        auto months = layout.backward ? -(layout.regular + 1 - i) * tenor : i * tenor;
+        unadjusted[static_cast<std::size_t>(i)] =
+            sys_days{roll(layout.backward ? spec.end : spec.start, months, layout.month_end)};
+    }
+    unadjusted[count - 1] = sys_days{spec.end};
+
+    auto is_business_day = [this](sys_days day) { return isBusinessDay(day); };
+    for (std::size_t i = 0; i < count; ++i) {
+        adjusted[i] =
+            detail::recordedAdjustDay(unadjusted[i], spec.convention, is_business_day);
+    }
+    return count;
+}
+
+void ScheduleGenerator::generate(std::span<const ScheduleSpec> specs,
+                                 std::span<const std::size_t> offsets,
+                                 std::span<sys_days> unadjusted, std::span<sys_days> adjusted,
+                                 unsigned threads) const {
+    if (offsets.size() != specs.size() + 1 || offsets.front() != 0) {
+        throw std::invalid_argument("Offsets must start at 0 and hold one entry per schedule "
+                                    "plus one");
+    }
+    const auto total = offsets.back();
+    if (unadjusted.size() < total || adjusted.size() < total) {
+        throw std::invalid_argument("Output buffers are too small for the schedules");
+    }
+
+    auto generate_range = [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            auto begin = offsets[i];
+            auto end = offsets[i + 1];
+            if (end < begin || end > total ||
+                generate(specs[i], unadjusted.subspan(begin, end - begin),
+                         adjusted.subspan(begin, end - begin)) != end - begin) {
+                throw std::invalid_argument("Offsets do not match the schedule sizes");
+            }
+        }
+    };
+
+    const std::size_t chunks = (specs.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::size_t workers = threads != 0 ? threads : std::thread::hardware_concurrency();
+    workers = std::min(std::max<std::size_t>(workers, 1), chunks);
+    if (workers <= 1) {
+        generate_range(0, specs.size());
+        return;
+    }
+
+    std::atomic<std::size_t> next_chunk{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    auto work = [&] {
+        while (!failed.load(std::memory_order_relaxed)) {
+            auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks) {
+                return;
+            }
+            try {
+                generate_range(chunk * CHUNK_SIZE,
+                               std::min(specs.size(), (chunk + 1) * CHUNK_SIZE));
+            } catch (...) {
+                std::scoped_lock lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    {
+        // The calling thread works too; the others are joined when the pool goes out of scope
+        std::vector<std::jthread> pool;
+        pool.reserve(workers - 1);
+        for (std::size_t i = 1; i < workers; ++i) {
+            pool.emplace_back(work);
+        }
+        work();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool ScheduleGenerator::isBusinessDay(sys_days day) const {
+    if (day < first_day_ || day >= end_day_) {
+        auto date = detail::toYearMonthDay(day);
+        return calendar_.getBusinessDayBitmap(static_cast<int>(date.year()), weekend_)
+            .test(YearBitmap::indexOf(date));
+    }
+    auto bit = static_cast<std::size_t>((day - first_day_).count());
+    return ((business_days_[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1U) != 0;
+}
+
+} // namespace datelib
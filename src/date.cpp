@@ -1,126 +1,465 @@
 #include "datelib/date.h"
 
+#include "datelib/CompiledCalendar.h"
 #include "datelib/HolidayCalendar.h"
+#include "datelib/JointCalendar.h"
+#include "datelib/MappedCalendar.h"
+#include "datelib/detail/adjust.h"
+#include "datelib/detail/civil.h"
+#include "datelib/detail/stats.h"
 #include "datelib/exceptions.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define DATELIB_HAS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
 namespace datelib {
 
 namespace {
-// Maximum number of days to search for a business day (one year)
-constexpr int MAX_DAYS_TO_SEARCH = 366;
+using detail::recordedAdjustDay;
+
+// Widest range of years classified through a flat day bitmap; wider inputs use per-year lookups
+constexpr int MAX_DAY_BITMAP_YEARS = 1000;
 
 /**
- * @brief Move forward to the next business day
+ * @brief Business day lookups that reuse the bitmaps of recently visited years
+ *
+ * A lookup in a year already held is a bit test; only moving to another year goes back to the
+ * calendar. Two years are held so that walks across a year boundary do not reload on every step.
+ *
+ * @tparam LoadYear Callable returning the business day YearBitmap of a year
  */
-std::chrono::year_month_day
-moveToNextBusinessDay(const std::chrono::year_month_day& start, const HolidayCalendar& calendar,
-                      const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days) {
-    auto adjusted = std::chrono::sys_days{start};
-    std::chrono::year_month_day adjusted_ymd{adjusted};
-    int iterations = 0;
-
-    while (!isBusinessDay(adjusted_ymd, calendar, weekend_days)) {
-        if (++iterations > MAX_DAYS_TO_SEARCH) {
-            throw BusinessDaySearchException(
-                "Unable to find next business day within reasonable range");
+template <typename LoadYear>
+class BusinessDayCursor {
+  public:
+    explicit BusinessDayCursor(LoadYear load_year) : load_year_(std::move(load_year)) {}
+
+    bool operator()(std::chrono::sys_days day) {
+        for (const auto& slot : slots_) {
+            if (day >= slot.start && day < slot.end) {
+                return slot.bitmap.test(static_cast<unsigned>((day - slot.start).count()));
+            }
         }
-        adjusted += std::chrono::days{1};
-        adjusted_ymd = std::chrono::year_month_day{adjusted};
+        return load(day).bitmap.test(YearBitmap::indexOf(detail::toYearMonthDay(day)));
     }
 
-    return adjusted_ymd;
+  private:
+    struct Slot {
+        std::chrono::sys_days start{};
+        std::chrono::sys_days end{};
+        YearBitmap bitmap;
+    };
+
+    const Slot& load(std::chrono::sys_days day) {
+        auto year = detail::toYearMonthDay(day).year();
+        auto& slot = slots_[next_slot_];
+        next_slot_ = (next_slot_ + 1) % slots_.size();
+
+        slot.start = std::chrono::sys_days{year / std::chrono::January / 1};
+        slot.end = std::chrono::sys_days{(year + std::chrono::years{1}) / std::chrono::January / 1};
+        slot.bitmap = load_year_(static_cast<int>(year));
+        return slot;
+    }
+
+    LoadYear load_year_;
+    std::array<Slot, 2> slots_{};
+    std::size_t next_slot_ = 0;
+};
+
+/**
+ * @brief Make a cursor over the business days of a holiday calendar
+ */
+auto businessDayCursor(const HolidayCalendar& calendar, WeekendMask weekend) {
+    return BusinessDayCursor(
+        [&calendar, weekend](int year) { return calendar.getBusinessDayBitmap(year, weekend); });
 }
 
 /**
- * @brief Move backward to the previous business day
+ * @brief Business days of a contiguous range of days, one bit per day
+ *
+ * Bit i is set when first + i days is a business day. Weekend days are folded in, so classifying
+ * a day is a single word fetch and bit test. Words are 32 bits wide so that vector kernels can
+ * fetch them with 32-bit gathers.
  */
-std::chrono::year_month_day moveToPreviousBusinessDay(
-    const std::chrono::year_month_day& start, const HolidayCalendar& calendar,
-    const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days) {
-    auto adjusted = std::chrono::sys_days{start};
-    std::chrono::year_month_day adjusted_ymd{adjusted};
-    int iterations = 0;
-
-    while (!isBusinessDay(adjusted_ymd, calendar, weekend_days)) {
-        if (++iterations > MAX_DAYS_TO_SEARCH) {
-            throw BusinessDaySearchException(
-                "Unable to find previous business day within reasonable range");
+struct DayBitmap {
+    std::chrono::sys_days first;
+    std::vector<std::uint32_t> words;
+};
+
+/**
+ * @brief Build the business day bitmap of every year from first_year to last_year
+ */
+DayBitmap buildDayBitmap(std::chrono::year first_year, std::chrono::year last_year,
+                         const HolidayCalendar& calendar, WeekendMask weekend) {
+    constexpr std::size_t BITS = 32;
+
+    DayBitmap bitmap;
+    bitmap.first = std::chrono::sys_days{first_year / std::chrono::January / 1};
+    std::chrono::sys_days end{(last_year + std::chrono::years{1}) / std::chrono::January / 1};
+    auto length = static_cast<std::size_t>((end - bitmap.first).count());
+    bitmap.words.assign((length + BITS - 1) / BITS, 0);
+
+    // Copy each year's bitmap to its (generally unaligned) position in the range
+    std::size_t offset = 0;
+    for (auto year = first_year; year <= last_year; ++year) {
+        auto year_bits = calendar.getBusinessDayBitmap(static_cast<int>(year), weekend);
+        for (std::size_t w = 0; w < YearBitmap::WORDS; ++w) {
+            for (std::size_t half = 0; half < 2; ++half) {
+                auto part = static_cast<std::uint32_t>(year_bits.words()[w] >> (BITS * half));
+                if (part == 0) {
+                    continue;
+                }
+                auto bit = offset + w * YearBitmap::WORD_BITS + half * BITS;
+                auto index = bit / BITS;
+                auto shift = bit % BITS;
+                bitmap.words[index] |= part << shift;
+                if (shift != 0 && index + 1 < bitmap.words.size()) {
+                    bitmap.words[index + 1] |= part >> (BITS - shift);
+                }
+            }
         }
-        adjusted -= std::chrono::days{1};
-        adjusted_ymd = std::chrono::year_month_day{adjusted};
+        offset += YearBitmap::lengthOf(static_cast<int>(year));
     }
 
-    return adjusted_ymd;
+    return bitmap;
+}
+
+/**
+ * @brief Classify days against a day bitmap, one at a time
+ */
+void classifyScalar(const std::chrono::sys_days* dates, std::uint8_t* results, std::size_t count,
+                    const DayBitmap& bitmap) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto offset = static_cast<std::size_t>((dates[i] - bitmap.first).count());
+        results[i] = static_cast<std::uint8_t>((bitmap.words[offset / 32] >> (offset % 32)) & 1U);
+    }
+}
+
+#ifdef DATELIB_HAS_AVX2_KERNEL
+/**
+ * @brief Test the bitmap bits of four consecutive days
+ * @return The four results as 32-bit lanes holding 0 or 1
+ */
+__attribute__((target("avx2"))) __m128i classify4Avx2(const long long* days, const int* words,
+                                                      long long first) {
+    __m256i offset = _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(days)),
+                                      _mm256_set1_epi64x(first));
+    __m128i word = _mm256_i64gather_epi32(words, _mm256_srli_epi64(offset, 5), 4);
+
+    // Bit positions come from the low 32 bits of each 64-bit offset
+    __m128i bit = _mm256_castsi256_si128(
+        _mm256_permutevar8x32_epi32(offset, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+    bit = _mm_and_si128(bit, _mm_set1_epi32(31));
+
+    return _mm_and_si128(_mm_srlv_epi32(word, bit), _mm_set1_epi32(1));
+}
+
+/**
+ * @brief Classify days against a day bitmap, eight at a time with AVX2 gathers
+ */
+__attribute__((target("avx2"))) void classifyAvx2(const std::chrono::sys_days* dates,
+                                                  std::uint8_t* results, std::size_t count,
+                                                  const DayBitmap& bitmap) {
+    static_assert(sizeof(std::chrono::sys_days) == sizeof(long long));
+
+    const auto* days = reinterpret_cast<const long long*>(dates);
+    const auto* words = reinterpret_cast<const int*>(bitmap.words.data());
+    const long long first = bitmap.first.time_since_epoch().count();
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm_packus_epi32(classify4Avx2(days + i, words, first),
+                                          classify4Avx2(days + i + 4, words, first));
+        packed = _mm_packus_epi16(packed, packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(results + i), packed);
+    }
+    classifyScalar(dates + i, results + i, count - i, bitmap);
+}
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+}
+#endif
+
+/**
+ * @brief Adjust a column of days, reusing the result for repeated days
+ * @param to_day Conversion from an input element to a valid std::chrono::sys_days
+ * @param from_day Conversion from std::chrono::sys_days to an output element
+ */
+template <typename In, typename Out, typename ToDay, typename FromDay>
+void adjustAll(std::span<const In> dates, std::span<Out> adjusted,
+               BusinessDayConvention convention, const HolidayCalendar& calendar,
+               WeekendMask weekend, ToDay to_day, FromDay from_day) {
+    if (adjusted.size() != dates.size()) {
+        throw std::invalid_argument("Input and output spans must have the same size");
+    }
+
+    auto cursor = businessDayCursor(calendar, weekend);
+    std::chrono::sys_days previous_day{};
+    std::chrono::sys_days previous_result{};
+
+    for (std::size_t i = 0; i < dates.size(); ++i) {
+        auto day = to_day(dates[i]);
+        if (i == 0 || day != previous_day) {
+            previous_day = day;
+            previous_result = recordedAdjustDay(day, convention, cursor);
+        }
+        adjusted[i] = from_day(previous_result);
+    }
+}
+
+/**
+ * @brief Check for a business day in a calendar with a fixed range of years
+ * @param calendar A CompiledCalendar or MappedCalendar
+ */
+template <typename Calendar>
+bool isBusinessDayIn(const std::chrono::year_month_day& date, const Calendar& calendar,
+                     WeekendMask weekend) {
+    detail::LatencyTimer timer(StatsOperation::IsBusinessDay);
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to isBusinessDay");
+    }
+
+    return !weekend.contains(detail::weekdayOf(detail::toSysDays(date))) &&
+           !calendar.isHoliday(date);
+}
+
+/**
+ * @brief Adjust a date in a calendar with a fixed range of years
+ * @param calendar A CompiledCalendar or MappedCalendar
+ */
+template <typename Calendar>
+std::chrono::year_month_day adjustIn(const std::chrono::year_month_day& date,
+                                     BusinessDayConvention convention, const Calendar& calendar,
+                                     WeekendMask weekend) {
+    detail::LatencyTimer timer(detail::adjustOperation(convention));
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to adjust");
+    }
+
+    // Days reached by the walk are valid, so each step is one weekday computation and, on
+    // weekdays, one conversion for the holiday lookup
+    auto is_business_day = [&](std::chrono::sys_days day) {
+        return !weekend.contains(detail::weekdayOf(day)) &&
+               !calendar.isHoliday(detail::toYearMonthDay(day));
+    };
+    return detail::toYearMonthDay(
+        recordedAdjustDay(detail::toSysDays(date), convention, is_business_day));
 }
 } // namespace
 
 bool isBusinessDay(const std::chrono::year_month_day& date, const HolidayCalendar& calendar,
-                   const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days) {
+                   WeekendMask weekend) {
+    detail::LatencyTimer timer(StatsOperation::IsBusinessDay);
+
     // Validate the date is well-formed
     if (!date.ok()) {
         throw std::invalid_argument("Invalid date provided to isBusinessDay");
     }
 
-    // Convert to sys_days to get the weekday
-    auto sys_days_date = std::chrono::sys_days{date};
-    std::chrono::weekday wd{sys_days_date};
-
     // Check if the day is not a weekend day
-    bool is_not_weekend = !weekend_days.contains(wd);
+    bool is_not_weekend = !weekend.contains(detail::weekdayOf(detail::toSysDays(date)));
 
     // A business day is not a weekend day and not a holiday
     return is_not_weekend && !calendar.isHoliday(date);
 }
 
+bool isBusinessDay(const std::chrono::year_month_day& date, const HolidayCalendar& calendar,
+                   const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days) {
+    return isBusinessDay(date, calendar, WeekendMask{weekend_days});
+}
+
+bool isBusinessDay(const std::chrono::year_month_day& date, const CompiledCalendar& calendar,
+                   WeekendMask weekend) {
+    return isBusinessDayIn(date, calendar, weekend);
+}
+
+bool isBusinessDay(const std::chrono::year_month_day& date, const MappedCalendar& calendar,
+                   WeekendMask weekend) {
+    return isBusinessDayIn(date, calendar, weekend);
+}
+
+bool isBusinessDay(const std::chrono::year_month_day& date, const JointCalendar& calendar) {
+    detail::LatencyTimer timer(StatsOperation::IsBusinessDay);
+    return calendar.isBusinessDay(date);
+}
+
+std::chrono::year_month_day adjust(const std::chrono::year_month_day& date,
+                                   BusinessDayConvention convention,
+                                   const HolidayCalendar& calendar, WeekendMask weekend) {
+    detail::LatencyTimer timer(detail::adjustOperation(convention));
+
+    // Validate the input date
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to adjust");
+    }
+
+    // Days reached by the walk are valid, so each step is one weekday computation and, on
+    // weekdays, one conversion for the holiday lookup
+    auto is_business_day = [&](std::chrono::sys_days day) {
+        return !weekend.contains(detail::weekdayOf(day)) &&
+               !calendar.isHoliday(detail::toYearMonthDay(day));
+    };
+    return detail::toYearMonthDay(
+        recordedAdjustDay(detail::toSysDays(date), convention, is_business_day));
+}
+
 std::chrono::year_month_day
 adjust(const std::chrono::year_month_day& date, BusinessDayConvention convention,
        const HolidayCalendar& calendar,
        const std::unordered_set<std::chrono::weekday, WeekdayHash>& weekend_days) {
-    // Validate the input date
+    return adjust(date, convention, calendar, WeekendMask{weekend_days});
+}
+
+std::chrono::year_month_day adjust(const std::chrono::year_month_day& date,
+                                   BusinessDayConvention convention,
+                                   const CompiledCalendar& calendar, WeekendMask weekend) {
+    return adjustIn(date, convention, calendar, weekend);
+}
+
+std::chrono::year_month_day adjust(const std::chrono::year_month_day& date,
+                                   BusinessDayConvention convention,
+                                   const MappedCalendar& calendar, WeekendMask weekend) {
+    return adjustIn(date, convention, calendar, weekend);
+}
+
+std::chrono::year_month_day adjust(const std::chrono::year_month_day& date,
+                                   BusinessDayConvention convention,
+                                   const JointCalendar& calendar) {
+    detail::LatencyTimer timer(detail::adjustOperation(convention));
     if (!date.ok()) {
         throw std::invalid_argument("Invalid date provided to adjust");
     }
 
-    // If already a business day, no adjustment needed
-    if (isBusinessDay(date, calendar, weekend_days)) {
-        return date;
+    BusinessDayCursor cursor([&calendar](int year) { return calendar.getBusinessDayBitmap(year); });
+    return detail::toYearMonthDay(recordedAdjustDay(detail::toSysDays(date), convention, cursor));
+}
+
+void adjust(std::span<const std::chrono::year_month_day> dates,
+            std::span<std::chrono::year_month_day> adjusted, BusinessDayConvention convention,
+            const HolidayCalendar& calendar, WeekendMask weekend) {
+    adjustAll(
+        dates, adjusted, convention, calendar, weekend,
+        [](const std::chrono::year_month_day& date) {
+            // Validate each input date
+            if (!date.ok()) {
+                throw std::invalid_argument("Invalid date provided to adjust");
+            }
+            return detail::toSysDays(date);
+        },
+        [](std::chrono::sys_days day) { return detail::toYearMonthDay(day); });
+}
+
+void adjust(std::span<const std::chrono::sys_days> dates, std::span<std::chrono::sys_days> adjusted,
+            BusinessDayConvention convention, const HolidayCalendar& calendar,
+            WeekendMask weekend) {
+    auto identity = [](std::chrono::sys_days day) { return day; };
+    adjustAll(dates, adjusted, convention, calendar, weekend, identity, identity);
+}
+
+void isBusinessDay(std::span<const std::chrono::sys_days> dates, std::span<std::uint8_t> results,
+                   const HolidayCalendar& calendar, WeekendMask weekend) {
+    if (results.size() != dates.size()) {
+        throw std::invalid_argument("Input and output spans must have the same size");
+    }
+    if (dates.empty()) {
+        return;
     }
 
-    // Apply the convention
-    using enum BusinessDayConvention;
-    switch (convention) {
-    case Following:
-        return moveToNextBusinessDay(date, calendar, weekend_days);
+    auto [min_day, max_day] = std::ranges::minmax(dates);
+    auto first_year = detail::toYearMonthDay(min_day).year();
+    auto last_year = detail::toYearMonthDay(max_day).year();
 
-    case ModifiedFollowing: {
-        auto adjusted = moveToNextBusinessDay(date, calendar, weekend_days);
-        // If we crossed into a new month, go backward instead
-        if (adjusted.month() != date.month()) {
-            adjusted = moveToPreviousBusinessDay(date, calendar, weekend_days);
+    // Dates scattered over a very wide range would need a very large bitmap
+    if (static_cast<int>(last_year) - static_cast<int>(first_year) >= MAX_DAY_BITMAP_YEARS) {
+        auto cursor = businessDayCursor(calendar, weekend);
+        for (std::size_t i = 0; i < dates.size(); ++i) {
+            results[i] = cursor(dates[i]) ? 1 : 0;
         }
-        return adjusted;
+        return;
     }
 
-    case Preceding:
-        return moveToPreviousBusinessDay(date, calendar, weekend_days);
+    auto bitmap = buildDayBitmap(first_year, last_year, calendar, weekend);
+#ifdef DATELIB_HAS_AVX2_KERNEL
+    if (hasAvx2()) {
+        classifyAvx2(dates.data(), results.data(), dates.size(), bitmap);
+        return;
+    }
+#endif
+    classifyScalar(dates.data(), results.data(), dates.size(), bitmap);
+}
 
-    case ModifiedPreceding: {
-        auto adjusted = moveToPreviousBusinessDay(date, calendar, weekend_days);
-        // If we crossed into a different month, go forward instead
-        if (adjusted.month() != date.month()) {
-            adjusted = moveToNextBusinessDay(date, calendar, weekend_days);
-        }
-        return adjusted;
+std::chrono::year_month_day addBusinessDays(const std::chrono::year_month_day& date, int n,
+                                            const HolidayCalendar& calendar, WeekendMask weekend) {
+    // Validate the input date
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date provided to addBusinessDays");
+    }
+
+    if (n == 0) {
+        return adjust(date, BusinessDayConvention::Following, calendar, weekend);
+    }
+
+    auto year = static_cast<int>(date.year());
+    const auto max_year = static_cast<int>(std::chrono::year::max());
+    const auto min_year = static_cast<int>(std::chrono::year::min());
+
+    // A year holds at most 366 days less 52 of each weekend day as business days, so a target
+    // further away than that cannot be represented; failing early also spares building the
+    // bitmap of every year on the way
+    const auto distance = n > 0 ? std::int64_t{n} : -std::int64_t{n};
+    const auto years_available = n > 0 ? max_year - year + 1 : year - min_year + 1;
+    const auto max_per_year = 366 - 52 * std::popcount(weekend.bits());
+    if (distance > std::int64_t{max_per_year} * years_available) {
+        throw BusinessDaySearchException("Business day offset leaves the range of years");
     }
 
-    case Unadjusted:
-        // Return the date unchanged
-        return date;
+    auto index = YearBitmap::indexOf(date);
+    auto bitmap = calendar.getBusinessDayBitmap(year, weekend);
+
+    if (n > 0) {
+        // Rank within the year of the nth business day after date; whole years are skipped by
+        // their business day count
+        auto rank = bitmap.count(0, index + 1) + static_cast<std::size_t>(n) - 1;
+        for (auto available = bitmap.count(); rank >= available; available = bitmap.count()) {
+            rank -= available;
+            if (year == max_year) {
+                throw BusinessDaySearchException("Business day offset leaves the range of years");
+            }
+            bitmap = calendar.getBusinessDayBitmap(++year, weekend);
+            if (bitmap.none()) {
+                throw BusinessDaySearchException(
+                    "Unable to find next business day within reasonable range");
+            }
+        }
+        return YearBitmap::dateAt(year, bitmap.select(rank));
     }
 
-    // This should never be reached as all enum values are handled above
-    // If we reach here, it's a logic error (e.g., uninitialized enum)
-    throw UnhandledEnumException("Unhandled BusinessDayConvention in adjust()");
+    // Count backward: 'available' business days lie before the date in the current year
+    auto remaining = static_cast<std::size_t>(-static_cast<std::int64_t>(n));
+    auto available = bitmap.count(0, index);
+    while (available < remaining) {
+        remaining -= available;
+        if (year == min_year) {
+            throw BusinessDaySearchException("Business day offset leaves the range of years");
+        }
+        bitmap = calendar.getBusinessDayBitmap(--year, weekend);
+        available = bitmap.count();
+        if (available == 0) {
+            throw BusinessDaySearchException(
+                "Unable to find previous business day within reasonable range");
+        }
+    }
+    return YearBitmap::dateAt(year, bitmap.select(available - remaining));
 }
 
 } // namespace datelib
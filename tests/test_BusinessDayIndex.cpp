@@ -0,0 +1,187 @@
+#include "datelib/BusinessDayIndex.h"
+#include "datelib/date.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+namespace {
+// Reference count of business days in [from, to) using one isBusinessDay call per day
+int countByWalking(const datelib::HolidayCalendar& calendar, sys_days from, sys_days to,
+                   datelib::WeekendMask weekend) {
+    int count = 0;
+    for (auto d = from; d < to; d += days{1}) {
+        if (datelib::isBusinessDay(year_month_day{d}, calendar, weekend)) {
+            ++count;
+        }
+    }
+    return count;
+}
+} // namespace
+
+TEST_CASE("BusinessDayIndex construction", "[BusinessDayIndex]") {
+    datelib::HolidayCalendar calendar;
+
+    SECTION("Valid horizon") {
+        datelib::BusinessDayIndex index(calendar, 2020, 2030);
+        REQUIRE(index.firstYear() == 2020);
+        REQUIRE(index.lastYear() == 2030);
+        REQUIRE(index.contains(year_month_day{year{2020}, month{1}, day{1}}));
+        REQUIRE(index.contains(year_month_day{year{2030}, month{12}, day{31}}));
+        REQUIRE_FALSE(index.contains(year_month_day{year{2031}, month{1}, day{1}}));
+        REQUIRE_FALSE(index.contains(year_month_day{year{2024}, month{2}, day{30}}));
+    }
+
+    SECTION("Reversed horizon") {
+        REQUIRE_THROWS_AS(datelib::BusinessDayIndex(calendar, 2030, 2020), std::invalid_argument);
+    }
+}
+
+TEST_CASE("BusinessDayIndex businessDaysBetween", "[BusinessDayIndex]") {
+    auto calendar = makeUsCalendar();
+    datelib::BusinessDayIndex index(calendar, 2023, 2026);
+
+    SECTION("Simple ranges") {
+        // Monday, January 1, 2024 is New Year's Day; January 2-5 are business days
+        REQUIRE(index.businessDaysBetween(year_month_day{year{2024}, month{1}, day{1}},
+                                          year_month_day{year{2024}, month{1}, day{8}}) == 4);
+        REQUIRE(index.businessDaysBetween(year_month_day{year{2024}, month{1}, day{8}},
+                                          year_month_day{year{2024}, month{1}, day{8}}) == 0);
+    }
+
+    SECTION("Reversed range is negative") {
+        REQUIRE(index.businessDaysBetween(year_month_day{year{2024}, month{1}, day{8}},
+                                          year_month_day{year{2024}, month{1}, day{1}}) == -4);
+    }
+
+    SECTION("Matches a day-by-day walk inside and across the horizon") {
+        auto start = sys_days{year{2021} / March / 14};
+        for (int from_offset = 0; from_offset < 3000; from_offset += 97) {
+            for (int length = 0; length < 2500; length += 131) {
+                auto from = start + days{from_offset};
+                auto to = from + days{length};
+                REQUIRE(index.businessDaysBetween(year_month_day{from}, year_month_day{to}) ==
+                        countByWalking(calendar, from, to, datelib::SATURDAY_SUNDAY_WEEKEND));
+            }
+        }
+    }
+
+    SECTION("Range entirely outside the horizon") {
+        auto from = sys_days{year{1999} / December / 1};
+        auto to = sys_days{year{2001} / February / 1};
+        REQUIRE(index.businessDaysBetween(year_month_day{from}, year_month_day{to}) ==
+                countByWalking(calendar, from, to, datelib::SATURDAY_SUNDAY_WEEKEND));
+    }
+
+    SECTION("Column of ranges matches the scalar count") {
+        std::vector<sys_days> from;
+        std::vector<sys_days> to;
+        auto start = sys_days{year{2021} / March / 14};
+        for (int from_offset = 0; from_offset < 3000; from_offset += 97) {
+            for (int length = -1500; length < 2500; length += 131) {
+                from.push_back(start + days{from_offset});
+                to.push_back(start + days{from_offset + length});
+            }
+        }
+
+        std::vector<int> counts(from.size());
+        index.businessDaysBetween(from, to, counts);
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            REQUIRE(counts[i] ==
+                    index.businessDaysBetween(year_month_day{from[i]}, year_month_day{to[i]}));
+        }
+
+        counts.pop_back();
+        REQUIRE_THROWS_WITH(index.businessDaysBetween(from, to, counts),
+                            "Input and output spans must have the same size");
+    }
+
+    SECTION("Invalid dates") {
+        REQUIRE_THROWS_WITH(index.businessDaysBetween(year_month_day{year{2024}, month{2}, day{30}},
+                                                      year_month_day{year{2024}, month{3}, day{1}}),
+                            "Invalid date provided to businessDaysBetween");
+    }
+}
+
+TEST_CASE("BusinessDayIndex ordinals", "[BusinessDayIndex]") {
+    auto calendar = makeUsCalendar();
+    datelib::BusinessDayIndex index(calendar, 2024, 2024);
+
+    SECTION("Business day of month") {
+        // Tuesday, January 2, 2024 is the first business day of January (January 1 is a holiday)
+        REQUIRE(index.businessDayOfMonth(year_month_day{year{2024}, month{1}, day{2}}) == 1);
+        REQUIRE(index.businessDayOfMonth(year_month_day{year{2024}, month{1}, day{5}}) == 4);
+        // Saturday, January 6, 2024 counts the business days before it
+        REQUIRE(index.businessDayOfMonth(year_month_day{year{2024}, month{1}, day{6}}) == 4);
+        // New Year's Day is before the first business day
+        REQUIRE(index.businessDayOfMonth(year_month_day{year{2024}, month{1}, day{1}}) == 0);
+        // Friday, February 2, 2024 is the second business day of February
+        REQUIRE(index.businessDayOfMonth(year_month_day{year{2024}, month{2}, day{2}}) == 2);
+    }
+
+    SECTION("Business day of year") {
+        REQUIRE(index.businessDayOfYear(year_month_day{year{2024}, month{1}, day{2}}) == 1);
+        // 2024 has 262 weekdays, four of which are holidays in this calendar
+        REQUIRE(index.businessDayOfYear(year_month_day{year{2024}, month{12}, day{31}}) == 258);
+    }
+
+    SECTION("Ordinals outside the horizon") {
+        // Thursday, January 9, 2025 is a special closing; January 2, 3, 6, 7, 8 are business days
+        REQUIRE(index.businessDayOfMonth(year_month_day{year{2025}, month{1}, day{10}}) == 6);
+        REQUIRE(index.businessDayOfYear(year_month_day{year{2025}, month{1}, day{10}}) == 6);
+    }
+}
+
+TEST_CASE("BusinessDayIndex isBusinessDay", "[BusinessDayIndex]") {
+    auto calendar = makeUsCalendar();
+    datelib::BusinessDayIndex index(calendar, 2024, 2025, datelib::FRIDAY_SATURDAY_WEEKEND);
+
+    auto start = sys_days{year{2023} / December / 1};
+    for (auto d = start; d < start + days{800}; d += days{1}) {
+        year_month_day ymd{d};
+        REQUIRE(index.isBusinessDay(ymd) ==
+                datelib::isBusinessDay(ymd, calendar, datelib::FRIDAY_SATURDAY_WEEKEND));
+    }
+
+    REQUIRE_THROWS_AS(index.isBusinessDay(year_month_day{year{2024}, month{2}, day{30}}),
+                      std::invalid_argument);
+}
+
+TEST_CASE("BusinessDayIndex addBusinessDays", "[BusinessDayIndex]") {
+    auto calendar = makeUsCalendar();
+    datelib::BusinessDayIndex index(calendar, 2024, 2025);
+
+    SECTION("Matches the calendar-based offset inside and across the horizon") {
+        auto start = sys_days{year{2023} / December / 1};
+        for (int offset = 0; offset < 800; offset += 7) {
+            for (int n : {0, 1, 2, 10, 300, 700, -1, -2, -10, -300, -700}) {
+                year_month_day date{start + days{offset}};
+                REQUIRE(index.addBusinessDays(date, n) ==
+                        datelib::addBusinessDays(date, n, calendar));
+            }
+        }
+    }
+
+    SECTION("T+2 over Thanksgiving") {
+        // Wednesday, November 27, 2024 + 2 skips Thanksgiving -> Monday, December 2, 2024
+        REQUIRE(index.addBusinessDays(year_month_day{year{2024}, month{11}, day{27}}, 2) ==
+                year_month_day{year{2024}, month{12}, day{2}});
+    }
+
+    SECTION("Targets outside the range of years") {
+        const year_month_day start{year{2024}, month{1}, day{2}};
+        REQUIRE_THROWS_AS(index.addBusinessDays(start, 10'000'000),
+                          datelib::BusinessDaySearchException);
+        REQUIRE_THROWS_AS(index.addBusinessDays(start, -10'000'000),
+                          datelib::BusinessDaySearchException);
+    }
+
+    SECTION("Invalid date") {
+        REQUIRE_THROWS_AS(index.addBusinessDays(year_month_day{year{2024}, month{2}, day{30}}, 1),
+                          std::invalid_argument);
+    }
+}
@@ -0,0 +1,147 @@
+#include "datelib/BusinessDayRange.h"
+#include "datelib/CompiledCalendar.h"
+#include "datelib/JointCalendar.h"
+#include "datelib/StaticCalendar.h"
+#include "datelib/date.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+namespace {
+/**
+ * @brief List the business days of [from, to) one day at a time
+ */
+template <typename IsBusinessDay>
+std::vector<sys_days> steppedDays(sys_days from, sys_days to, IsBusinessDay is_business_day) {
+    std::vector<sys_days> result;
+    for (auto day = from; day < to; day += std::chrono::days{1}) {
+        if (is_business_day(year_month_day{day})) {
+            result.push_back(day);
+        }
+    }
+    return result;
+}
+
+template <typename Range>
+std::vector<sys_days> collect(Range&& range) {
+    std::vector<sys_days> result;
+    std::ranges::copy(range, std::back_inserter(result));
+    return result;
+}
+} // namespace
+
+static_assert(std::ranges::forward_range<datelib::BusinessDayRange<datelib::HolidayCalendar>>);
+static_assert(std::ranges::view<datelib::BusinessDayRange<datelib::HolidayCalendar>>);
+static_assert(std::ranges::borrowed_range<datelib::BusinessDayRange<datelib::HolidayCalendar>>);
+
+TEST_CASE("businessDays visits business days in order", "[BusinessDayRange]") {
+    auto calendar = makeUsCalendar();
+
+    SECTION("Weekends and holidays are skipped") {
+        // Christmas 2024 is a Wednesday
+        REQUIRE(collect(datelib::businessDays(year{2024} / December / 20,
+                                              year{2024} / December / 28, calendar)) ==
+                std::vector<sys_days>{year{2024} / December / 20, year{2024} / December / 23,
+                                      year{2024} / December / 24, year{2024} / December / 26,
+                                      year{2024} / December / 27});
+    }
+
+    SECTION("Bounds are half-open") {
+        // Friday to Monday
+        auto days =
+            datelib::businessDays(year{2024} / March / 8, year{2024} / March / 11, calendar);
+        REQUIRE(std::ranges::distance(days) == 1);
+        REQUIRE(days.front() == sys_days{year{2024} / March / 8});
+
+        REQUIRE(datelib::businessDays(year{2024} / March / 9, year{2024} / March / 11, calendar)
+                    .empty());
+        REQUIRE(datelib::businessDays(year{2024} / March / 11, year{2024} / March / 8, calendar)
+                    .empty());
+        REQUIRE(datelib::businessDays(year{2024} / March / 11, year{2024} / March / 11, calendar)
+                    .empty());
+    }
+
+    SECTION("Same days as stepping through every day") {
+        sys_days from = year{2019} / November / 17;
+        sys_days to = year{2026} / February / 3;
+        auto is_business_day = [&](const year_month_day& date) {
+            return datelib::isBusinessDay(date, calendar);
+        };
+        REQUIRE(collect(datelib::businessDays(from, to, calendar)) ==
+                steppedDays(from, to, is_business_day));
+
+        auto is_gulf_business_day = [&](const year_month_day& date) {
+            return datelib::isBusinessDay(date, calendar, datelib::FRIDAY_SATURDAY_WEEKEND);
+        };
+        REQUIRE(collect(datelib::businessDays(from, to, calendar,
+                                              datelib::FRIDAY_SATURDAY_WEEKEND)) ==
+                steppedDays(from, to, is_gulf_business_day));
+    }
+
+    SECTION("Usable with range adaptors and algorithms") {
+        auto days = datelib::businessDays(year{2024} / January / 1, year{2025} / January / 1,
+                                          calendar);
+        // 262 weekdays less four holidays
+        REQUIRE(std::ranges::distance(days) == 258);
+
+        auto fridays = days | std::views::filter([](sys_days day) {
+                           return weekday{day} == Friday;
+                       });
+        REQUIRE(std::ranges::distance(fridays) == 52);
+
+        auto last = std::ranges::max(days);
+        REQUIRE(last == sys_days{year{2024} / December / 31});
+    }
+
+    SECTION("Iterators are independent of the view") {
+        auto it = datelib::businessDays(year{2024} / July / 3, year{2024} / July / 9, calendar)
+                      .begin();
+        auto copy = it++;
+        REQUIRE(*copy == sys_days{year{2024} / July / 3});
+        REQUIRE(*it == sys_days{year{2024} / July / 5});
+        REQUIRE(*++copy == *it);
+        REQUIRE(copy == it);
+    }
+}
+
+TEST_CASE("businessDays over other calendars", "[BusinessDayRange]") {
+    auto calendar = makeUsCalendar();
+    sys_days from = year{2024} / January / 1;
+    sys_days to = year{2026} / January / 1;
+    auto expected = collect(datelib::businessDays(from, to, calendar));
+
+    SECTION("CompiledCalendar up to the end of its range") {
+        auto compiled = calendar.freeze(2024, 2025);
+        REQUIRE(collect(datelib::businessDays(from, to, compiled)) == expected);
+        auto past_range = datelib::businessDays(from, to + std::chrono::days{1}, compiled);
+        REQUIRE_THROWS_AS(collect(past_range), datelib::YearOutOfRangeException);
+    }
+
+    SECTION("StaticCalendar") {
+        constexpr datelib::StaticCalendar<2020, 2030> static_calendar{
+            datelib::FixedDate{1, 1}, datelib::FixedDate{7, 4},
+            datelib::NthWeekday{11, 4, datelib::Occurrence::Fourth}, datelib::FixedDate{12, 25},
+            datelib::ExplicitDate{year_month_day{year{2025}, month{1}, day{9}}}};
+        REQUIRE(collect(datelib::businessDays(from, to, static_calendar)) == expected);
+    }
+
+    SECTION("JointCalendar") {
+        datelib::JointCalendar joint;
+        joint.add(calendar);
+        REQUIRE(collect(datelib::businessDays(from, to, joint)) == expected);
+
+        joint.add(datelib::HolidayCalendar{}, datelib::FRIDAY_SATURDAY_WEEKEND);
+        auto is_business_day = [&](const year_month_day& date) {
+            return joint.isBusinessDay(date);
+        };
+        REQUIRE(collect(datelib::businessDays(from, to, joint)) ==
+                steppedDays(from, to, is_business_day));
+    }
+}
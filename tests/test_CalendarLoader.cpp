@@ -0,0 +1,134 @@
+#include "datelib/CalendarLoader.h"
+#include "datelib/HolidayCalendar.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+using namespace std::chrono;
+
+namespace {
+constexpr std::string_view US_DEFINITIONS = "# United States\n"
+                                            "fixed,1,1,New Year's Day\n"
+                                            "nth,5,1,last,Memorial Day\n"
+                                            "nth,11,4,4,Thanksgiving\r\n"
+                                            "\n"
+                                            "fixed,12,25,Christmas\n"
+                                            "date,2025-01-09,National Day of Mourning\n"
+                                            "date,2024-12-24,Christmas Eve, observed\n"
+                                            "date,2025-12-24,Christmas Eve, observed";
+
+std::string isoDate(const year_month_day& date) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", static_cast<int>(date.year()),
+                  static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+    return buffer;
+}
+} // namespace
+
+TEST_CASE("loadCalendar parses every definition type", "[CalendarLoader]") {
+    datelib::HolidayCalendar calendar;
+    auto statistics = datelib::loadCalendar(US_DEFINITIONS, calendar);
+
+    REQUIRE(statistics.bytes == US_DEFINITIONS.size());
+    REQUIRE(statistics.lines == 9);
+    REQUIRE(statistics.rules == 4);
+    REQUIRE(statistics.holidays == 3);
+    REQUIRE(statistics.megabytesPerSecond() >= 0.0);
+
+    REQUIRE(calendar.getHolidays(2024) == std::vector<year_month_day>{
+                                              year{2024} / January / 1,
+                                              year{2024} / May / 27,
+                                              year{2024} / November / 28,
+                                              year{2024} / December / 24,
+                                              year{2024} / December / 25,
+                                          });
+    REQUIRE(calendar.getHolidayNames(year{2025} / January / 9) ==
+            std::vector<std::string>{"National Day of Mourning"});
+    REQUIRE(calendar.getHolidayNames(year{2025} / December / 24) ==
+            std::vector<std::string>{"Christmas Eve, observed"});
+}
+
+TEST_CASE("loadCalendar parses Easter-relative rules", "[CalendarLoader]") {
+    datelib::HolidayCalendar calendar;
+    auto statistics = datelib::loadCalendar("easter,-2,western,Good Friday\n"
+                                            "easter,1,orthodox,Orthodox Easter Monday\n",
+                                            calendar);
+    REQUIRE(statistics.rules == 2);
+    REQUIRE(calendar.getHolidays(2024) ==
+            std::vector<year_month_day>{year{2024} / March / 29, year{2024} / May / 6});
+}
+
+TEST_CASE("loadCalendar from a stream matches loading from memory", "[CalendarLoader]") {
+    // Enough lines to span several read blocks, with lines cut at block boundaries
+    std::string text(US_DEFINITIONS);
+    text += '\n';
+    for (int i = 0; i < 60000; ++i) {
+        auto date = sys_days{year{2000} / January / 1} + days{i % 20000};
+        text += "date," + isoDate(year_month_day{date}) + ",Closing " +
+                std::to_string(i % 7) + "\n";
+    }
+
+    datelib::HolidayCalendar from_memory;
+    datelib::loadCalendar(text, from_memory);
+
+    std::istringstream input(text);
+    datelib::HolidayCalendar from_stream;
+    auto statistics = datelib::loadCalendar(input, from_stream);
+
+    REQUIRE(statistics.bytes == text.size());
+    REQUIRE(statistics.holidays == 60003);
+    for (int y = 2000; y <= 2055; ++y) {
+        REQUIRE(from_stream.getHolidayBitmap(y) == from_memory.getHolidayBitmap(y));
+    }
+    auto date = year{2010} / March / 3;
+    REQUIRE(from_stream.getHolidayNames(date) == from_memory.getHolidayNames(date));
+    REQUIRE(from_stream.getHolidayNames(date).size() == 3);
+}
+
+TEST_CASE("loadCalendar adds to an existing calendar", "[CalendarLoader]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addHoliday("Existing", year{2024} / March / 1);
+    auto copy = calendar;
+
+    datelib::loadCalendar("date,2024-03-04,Loaded\n", calendar);
+    REQUIRE(calendar.isHoliday(year{2024} / March / 1));
+    REQUIRE(calendar.isHoliday(year{2024} / March / 4));
+    REQUIRE_FALSE(copy.isHoliday(year{2024} / March / 4));
+}
+
+TEST_CASE("loadCalendar reports malformed lines", "[CalendarLoader]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addHoliday("Existing", year{2024} / March / 1);
+
+    auto require_error = [&](std::string_view text, std::size_t line) {
+        try {
+            (void)datelib::loadCalendar(text, calendar);
+            FAIL("No exception for: " << text);
+        } catch (const datelib::CalendarParseException& e) {
+            REQUIRE(e.line() == line);
+        }
+        // A failed load leaves the calendar unchanged
+        REQUIRE(calendar.getHolidays(2024) == std::vector<year_month_day>{year{2024} / March / 1});
+    };
+
+    require_error("date,2024-03-04,Fine\nholiday,2024-03-05,Unknown type\n", 2);
+    require_error("date,2024-02-30,Invalid date\n", 1);
+    require_error("date,2024-03,Short date\n", 1);
+    require_error("date,2024-03-0x,Trailing characters\n", 1);
+    require_error("date,+2024-03-04,Signed year\n", 1);
+    require_error("# comment\ndate,2024-03-05\n", 2);
+    require_error("date,2024-03-05,\n", 1);
+    require_error("fixed,13,1,Bad month\n", 1);
+    require_error("fixed,-1,1,Negative month\n", 1);
+    require_error("nth,11,4,6,Bad occurrence\n", 1);
+    require_error("nth,11,7,last,Bad weekday\n", 1);
+    require_error("easter,1,catholic,Bad Easter type\n", 1);
+    require_error("easter,+1,western,Signed offset\n", 1);
+
+    std::istringstream input("fixed,1,1,New Year\n\nnth,1,1,first,Bad occurrence");
+    REQUIRE_THROWS_AS(datelib::loadCalendar(input, calendar), datelib::CalendarParseException);
+    REQUIRE(calendar.getHolidays(2024) == std::vector<year_month_day>{year{2024} / March / 1});
+}
@@ -0,0 +1,124 @@
+#include "datelib/HolidayCalendar.h"
+#include "datelib/date.h"
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+TEST_CASE("CompiledCalendar construction", "[CompiledCalendar]") {
+    auto calendar = makeUsCalendarWithSharedDate();
+
+    SECTION("Valid range") {
+        auto compiled = calendar.freeze(2020, 2030);
+        REQUIRE(compiled.firstYear() == 2020);
+        REQUIRE(compiled.lastYear() == 2030);
+        REQUIRE(compiled.contains(year_month_day{year{2030}, month{12}, day{31}}));
+        REQUIRE_FALSE(compiled.contains(year_month_day{year{2031}, month{1}, day{1}}));
+        REQUIRE_FALSE(compiled.contains(year_month_day{year{2024}, month{2}, day{30}}));
+    }
+
+    SECTION("Reversed range") {
+        REQUIRE_THROWS_AS(calendar.freeze(2030, 2020), std::invalid_argument);
+    }
+
+    SECTION("Snapshot is unaffected by later changes") {
+        auto compiled = calendar.freeze(2024, 2024);
+        calendar.addHoliday("Late Addition", year_month_day{year{2024}, month{3}, day{1}});
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{3}, day{1}}));
+        REQUIRE_FALSE(compiled.isHoliday(year_month_day{year{2024}, month{3}, day{1}}));
+    }
+}
+
+TEST_CASE("CompiledCalendar matches its source calendar", "[CompiledCalendar]") {
+    auto calendar = makeUsCalendarWithSharedDate();
+    auto compiled = calendar.freeze(2023, 2026);
+
+    SECTION("isHoliday, getHolidayNames and getHolidayNameIds") {
+        auto start = sys_days{year{2023} / January / 1};
+        for (auto d = start; d < sys_days{year{2027} / January / 1}; d += days{1}) {
+            year_month_day date{d};
+            REQUIRE(compiled.isHoliday(date) == calendar.isHoliday(date));
+            REQUIRE(compiled.getHolidayNames(date) == calendar.getHolidayNames(date));
+
+            std::vector<std::uint32_t> ids;
+            calendar.getHolidayNameIds(date, std::back_inserter(ids));
+            auto compiled_ids = compiled.getHolidayNameIds(date);
+            REQUIRE(std::vector<std::uint32_t>(compiled_ids.begin(), compiled_ids.end()) == ids);
+        }
+    }
+
+    SECTION("getHolidays") {
+        for (int y = 2023; y <= 2026; ++y) {
+            REQUIRE(compiled.getHolidays(y) == calendar.getHolidays(y));
+            REQUIRE(compiled.getHolidayBitmap(y) == calendar.getHolidayBitmap(y));
+        }
+    }
+
+    SECTION("Flat holiday array is sorted and distinct") {
+        auto holidays = compiled.holidays();
+        // Four rules a year plus one explicit date; Founders Day shares Christmas 2024
+        REQUIRE(holidays.size() == 17);
+        for (std::size_t i = 1; i < holidays.size(); ++i) {
+            REQUIRE(holidays[i - 1] < holidays[i]);
+        }
+    }
+
+    SECTION("Names of a shared date keep rule order") {
+        auto names = compiled.getHolidayNames(year_month_day{year{2024}, month{12}, day{25}});
+        REQUIRE(names == std::vector<std::string>{"Christmas", "Founders Day"});
+
+        auto ids = compiled.getHolidayNameIds(year_month_day{year{2024}, month{12}, day{25}});
+        REQUIRE(ids.size() == 2);
+        REQUIRE(datelib::holidayName(ids[0]) == "Christmas");
+        REQUIRE(ids[1] == datelib::internHolidayName("Founders Day"));
+    }
+
+    SECTION("Invalid dates are not holidays") {
+        REQUIRE_FALSE(compiled.isHoliday(year_month_day{year{2024}, month{2}, day{30}}));
+        REQUIRE(compiled.getHolidayNames(year_month_day{year{2024}, month{2}, day{30}}).empty());
+        REQUIRE(compiled.getHolidayNameIds(year_month_day{year{2024}, month{2}, day{30}}).empty());
+    }
+}
+
+TEST_CASE("CompiledCalendar outside its range", "[CompiledCalendar]") {
+    auto compiled = makeUsCalendarWithSharedDate().freeze(2024, 2025);
+
+    REQUIRE_THROWS_AS(compiled.isHoliday(year_month_day{year{2026}, month{1}, day{1}}),
+                      datelib::YearOutOfRangeException);
+    REQUIRE_THROWS_AS(compiled.getHolidays(2023), std::out_of_range);
+    // New Year's Day 2024 is a holiday; the previous business day lies in 2023
+    REQUIRE_THROWS_AS(datelib::adjust(year_month_day{year{2024}, month{1}, day{1}},
+                                      datelib::BusinessDayConvention::Preceding, compiled),
+                      datelib::YearOutOfRangeException);
+}
+
+TEST_CASE("Business day functions over a CompiledCalendar", "[CompiledCalendar]") {
+    using enum datelib::BusinessDayConvention;
+    auto calendar = makeUsCalendarWithSharedDate();
+    auto compiled = calendar.freeze(2023, 2026);
+
+    auto start = sys_days{year{2024} / January / 1};
+    for (auto d = start; d < sys_days{year{2026} / January / 1}; d += days{1}) {
+        year_month_day date{d};
+        REQUIRE(datelib::isBusinessDay(date, compiled) == datelib::isBusinessDay(date, calendar));
+        REQUIRE(datelib::isBusinessDay(date, compiled, datelib::FRIDAY_SATURDAY_WEEKEND) ==
+                datelib::isBusinessDay(date, calendar, datelib::FRIDAY_SATURDAY_WEEKEND));
+        for (auto convention : {Following, ModifiedFollowing, Preceding, ModifiedPreceding}) {
+            REQUIRE(datelib::adjust(date, convention, compiled) ==
+                    datelib::adjust(date, convention, calendar));
+        }
+    }
+
+    REQUIRE_THROWS_AS(datelib::isBusinessDay(year_month_day{year{2024}, month{2}, day{30}},
+                                             compiled),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::adjust(year_month_day{year{2024}, month{2}, day{30}}, Following,
+                                      compiled),
+                      std::invalid_argument);
+}
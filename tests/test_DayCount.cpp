@@ -0,0 +1,136 @@
+#include "datelib/BusinessDayIndex.h"
+#include "datelib/DayCount.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+using namespace std::chrono;
+
+namespace {
+datelib::HolidayCalendar makeCalendar() {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Tiradentes", 4, 21));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    return calendar;
+}
+
+constexpr datelib::DayCountConvention CALENDAR_FREE_CONVENTIONS[] = {
+    datelib::DayCountConvention::Actual360, datelib::DayCountConvention::Actual365Fixed,
+    datelib::DayCountConvention::Thirty360, datelib::DayCountConvention::ThirtyE360,
+    datelib::DayCountConvention::ActualActualISDA};
+} // namespace
+
+TEST_CASE("yearFraction calendar-free conventions", "[DayCount]") {
+    using enum datelib::DayCountConvention;
+
+    SECTION("Actual conventions") {
+        // 182 days
+        auto start = year{2024} / January / 1;
+        auto end = year{2024} / July / 1;
+        REQUIRE(datelib::yearFraction(start, end, Actual360) == 182 / 360.0);
+        REQUIRE(datelib::yearFraction(start, end, Actual365Fixed) == 182 / 365.0);
+        REQUIRE(datelib::yearFraction(start, end, ActualActualISDA) == 182 / 366.0);
+    }
+
+    SECTION("30/360 variants differ on the 31st") {
+        auto start = year{2024} / January / 15;
+        auto end = year{2024} / March / 31;
+        REQUIRE(datelib::yearFraction(start, end, Thirty360) == 76 / 360.0);
+        REQUIRE(datelib::yearFraction(start, end, ThirtyE360) == 75 / 360.0);
+
+        start = year{2024} / January / 31;
+        REQUIRE(datelib::yearFraction(start, end, Thirty360) == 60 / 360.0);
+        REQUIRE(datelib::yearFraction(start, end, ThirtyE360) == 60 / 360.0);
+
+        // The end of February is not moved by either variant
+        start = year{2024} / February / 29;
+        end = year{2024} / August / 31;
+        REQUIRE(datelib::yearFraction(start, end, Thirty360) == 182 / 360.0);
+        REQUIRE(datelib::yearFraction(start, end, ThirtyE360) == 181 / 360.0);
+    }
+
+    SECTION("ACT/ACT ISDA splits periods at year ends") {
+        // 61 days of 2023 and 60 days of the leap year 2024
+        REQUIRE(datelib::yearFraction(year{2023} / November / 1, year{2024} / March / 1,
+                                      ActualActualISDA) == Approx(61 / 365.0 + 60 / 366.0));
+        // Half of 2023, all of 2024 and 2025, and 181 days of 2026
+        REQUIRE(datelib::yearFraction(year{2023} / July / 1, year{2026} / July / 1,
+                                      ActualActualISDA) == Approx(184 / 365.0 + 2 + 181 / 365.0));
+        REQUIRE(datelib::yearFraction(year{2024} / January / 1, year{2025} / January / 1,
+                                      ActualActualISDA) == 1.0);
+    }
+
+    SECTION("Reversed periods are negative") {
+        auto start = year{2023} / March / 31;
+        auto end = year{2025} / August / 30;
+        for (auto convention : CALENDAR_FREE_CONVENTIONS) {
+            REQUIRE(datelib::yearFraction(end, start, convention) ==
+                    -datelib::yearFraction(start, end, convention));
+            REQUIRE(datelib::yearFraction(start, start, convention) == 0.0);
+        }
+    }
+
+    SECTION("Invalid arguments") {
+        REQUIRE_THROWS_WITH(datelib::yearFraction(year{2024} / February / 30,
+                                                  year{2024} / March / 1, Actual360),
+                            "Invalid date provided to yearFraction");
+        REQUIRE_THROWS_WITH(datelib::yearFraction(year{2024} / January / 1,
+                                                  year{2024} / March / 1, Business252),
+                            "BUS/252 year fractions need a BusinessDayIndex");
+    }
+}
+
+TEST_CASE("yearFractions columns", "[DayCount]") {
+    std::minstd_rand rng(11);
+    std::vector<sys_days> starts(5000);
+    std::vector<sys_days> ends(starts.size());
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        starts[i] = sys_days{year{1990} / January / 1} + days{rng() % 20000};
+        ends[i] = starts[i] + days{static_cast<int>(rng() % 8000) - 1000};
+    }
+    std::vector<double> fractions(starts.size());
+
+    SECTION("Same results as the scalar functions") {
+        for (auto convention : CALENDAR_FREE_CONVENTIONS) {
+            datelib::yearFractions(starts, ends, fractions, convention);
+            for (std::size_t i = 0; i < starts.size(); ++i) {
+                REQUIRE(fractions[i] == datelib::yearFraction(year_month_day{starts[i]},
+                                                              year_month_day{ends[i]},
+                                                              convention));
+            }
+        }
+    }
+
+    SECTION("BUS/252 counts business days from the index") {
+        auto calendar = makeCalendar();
+        datelib::BusinessDayIndex index(calendar, 2000, 2030);
+
+        datelib::yearFractions(starts, ends, fractions, index);
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            year_month_day start{starts[i]};
+            year_month_day end{ends[i]};
+            REQUIRE(fractions[i] == datelib::yearFraction(start, end, index));
+            REQUIRE(fractions[i] == index.businessDaysBetween(start, end) / 252.0);
+        }
+    }
+
+    SECTION("Size mismatches") {
+        fractions.pop_back();
+        REQUIRE_THROWS_WITH(datelib::yearFractions(starts, ends, fractions,
+                                                   datelib::DayCountConvention::Actual360),
+                            "Input and output spans must have the same size");
+        datelib::BusinessDayIndex index(makeCalendar(), 2020, 2021);
+        REQUIRE_THROWS_WITH(datelib::yearFractions(starts, ends, fractions, index),
+                            "Input and output spans must have the same size");
+    }
+
+    SECTION("BUS/252 needs an index") {
+        REQUIRE_THROWS_WITH(datelib::yearFractions(starts, ends, fractions,
+                                                   datelib::DayCountConvention::Business252),
+                            "BUS/252 year fractions need a BusinessDayIndex");
+    }
+}
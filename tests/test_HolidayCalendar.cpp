@@ -1,5 +1,14 @@
 #include "datelib/HolidayCalendar.h"
 
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "catch2/catch.hpp"
 
 using namespace std::chrono;
@@ -53,20 +62,87 @@ TEST_CASE("HolidayCalendar with explicit dates", "[HolidayCalendar]") {
         REQUIRE(names.size() == 1);
         REQUIRE(names[0] == "Eclipse Day");
 
-        // Querying for a different year returns no holidays (explicit rules only apply to their
+        // Querying for a different year returns no holidays (explicit dates only apply to their
         // specific year)
         auto holidays2025 = calendar.getHolidays(2025);
         REQUIRE(holidays2025.empty());
 
-        // Test isHoliday with explicit date from different year (triggers exception path)
+        // Same month and day in a different year is not a holiday
         REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2025}, month{4}, day{8}}));
 
-        // Test getHolidayNames with explicit date from different year (triggers exception path)
         auto names2025 = calendar.getHolidayNames(year_month_day{year{2025}, month{4}, day{8}});
         REQUIRE(names2025.empty());
     }
 }
 
+TEST_CASE("HolidayCalendar explicit holiday store", "[HolidayCalendar]") {
+    datelib::HolidayCalendar calendar;
+
+    SECTION("Bulk loading") {
+        std::vector<year_month_day> closures;
+        for (auto d = sys_days{year{1950} / January / 3}; d < sys_days{year{2101} / January / 1};
+             d += days{30}) {
+            closures.emplace_back(d);
+        }
+        calendar.addHolidays("Exchange Closed", closures);
+
+        REQUIRE(calendar.getHolidays(1950).size() == 13);
+        for (const auto& date : closures) {
+            REQUIRE(calendar.isHoliday(date));
+        }
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{1950}, month{1}, day{4}}));
+        REQUIRE(calendar.getHolidayNames(closures[100]) ==
+                std::vector<std::string>{"Exchange Closed"});
+    }
+
+    SECTION("Dates added out of order") {
+        calendar.addHoliday("Third", year_month_day{year{2024}, month{9}, day{20}});
+        calendar.addHoliday("First", year_month_day{year{2023}, month{4}, day{8}});
+        calendar.addHoliday("Second", year_month_day{year{2024}, month{6}, day{15}});
+
+        REQUIRE(calendar.getHolidays(2024) ==
+                std::vector<year_month_day>{year_month_day{year{2024}, month{6}, day{15}},
+                                            year_month_day{year{2024}, month{9}, day{20}}});
+        REQUIRE(calendar.isHoliday(year_month_day{year{2023}, month{4}, day{8}}));
+
+        // Adding after a query sorts again on the next query
+        calendar.addHoliday("Zeroth", year_month_day{year{2024}, month{1}, day{2}});
+        REQUIRE(calendar.getHolidays(2024).size() == 3);
+        REQUIRE(calendar.getHolidayNames(year_month_day{year{2024}, month{1}, day{2}}) ==
+                std::vector<std::string>{"Zeroth"});
+    }
+
+    SECTION("Names on a shared date") {
+        calendar.addHoliday("Founders Day", year_month_day{year{2024}, month{12}, day{25}});
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+        calendar.addHoliday("Company Holiday", year_month_day{year{2024}, month{12}, day{25}});
+
+        // Rule names come first, then explicit names in the order they were added
+        REQUIRE(calendar.getHolidayNames(year_month_day{year{2024}, month{12}, day{25}}) ==
+                std::vector<std::string>{"Christmas", "Founders Day", "Company Holiday"});
+        REQUIRE(calendar.getHolidays(2024).size() == 1);
+    }
+
+    SECTION("Invalid dates are rejected") {
+        std::vector<year_month_day> dates{year_month_day{year{2024}, month{1}, day{2}},
+                                          year_month_day{year{2023}, month{2}, day{29}}};
+        REQUIRE_THROWS_AS(calendar.addHolidays("Closed", dates), std::invalid_argument);
+        REQUIRE_THROWS_AS(calendar.addHoliday("Closed", dates[1]), std::invalid_argument);
+        REQUIRE(calendar.getHolidays(2024).empty());
+    }
+
+    SECTION("Copies taken before sorting") {
+        calendar.addHoliday("Later", year_month_day{year{2024}, month{9}, day{20}});
+        calendar.addHoliday("Earlier", year_month_day{year{2024}, month{6}, day{15}});
+        auto copy = calendar;
+
+        REQUIRE(calendar.getHolidays(2024).size() == 2);
+        copy.addHoliday("Earliest", year_month_day{year{2024}, month{3}, day{1}});
+        REQUIRE(copy.getHolidays(2024).size() == 3);
+        REQUIRE(calendar.getHolidays(2024).size() == 2);
+    }
+}
+
 TEST_CASE("HolidayCalendar with rules", "[HolidayCalendar]") {
     datelib::HolidayCalendar calendar;
 
@@ -92,6 +168,18 @@ TEST_CASE("HolidayCalendar with rules", "[HolidayCalendar]") {
         REQUIRE(holidays[1] == year_month_day{year{2024}, month{11}, day{28}});
         REQUIRE(holidays[2] == year_month_day{year{2024}, month{12}, day{25}});
     }
+
+    SECTION("Easter-relative rules") {
+        calendar.addRule(std::make_unique<datelib::EasterOffsetRule>("Good Friday", -2));
+        calendar.addRule(std::make_unique<datelib::EasterOffsetRule>("Easter Monday", 1));
+
+        // One rule per holiday covers every year
+        for (int y = 2000; y <= 2100; ++y) {
+            REQUIRE(calendar.getHolidays(y).size() == 2);
+        }
+        REQUIRE(calendar.getHolidayNames(year_month_day{year{2025}, month{4}, day{21}}) ==
+                std::vector<std::string>{"Easter Monday"});
+    }
 }
 
 TEST_CASE("HolidayCalendar with mixed explicit and rule-based", "[HolidayCalendar]") {
@@ -131,6 +219,170 @@ TEST_CASE("HolidayCalendar getHolidayNames", "[HolidayCalendar]") {
     }
 }
 
+TEST_CASE("HolidayCalendar forEachHoliday", "[HolidayCalendar]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::ObservedRule>(
+        std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1)));
+    calendar.addRule(std::make_unique<datelib::NthWeekdayRule>("Thanksgiving", 11, 4,
+                                                               datelib::Occurrence::Fourth));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    calendar.addHoliday("Day of Mourning", year_month_day{year{2023}, month{1}, day{9}});
+    calendar.addHoliday("Christmas Eve", year_month_day{year{2024}, month{12}, day{24}});
+    calendar.addHoliday("Day of Giving", year_month_day{year{2021}, month{11}, day{25}});
+    calendar.addHoliday("Harvest Festival", year_month_day{year{2021}, month{11}, day{25}});
+
+    auto holiday = [](const year_month_day& date, std::string_view name) {
+        return datelib::Holiday{date, name, datelib::internHolidayName(name)};
+    };
+    auto collect = [&](const year_month_day& from, const year_month_day& to) {
+        std::vector<datelib::Holiday> holidays;
+        calendar.forEachHoliday(
+            from, to, [&](const datelib::Holiday& holiday) { holidays.push_back(holiday); });
+        return holidays;
+    };
+
+    SECTION("Same holidays and names as the per-year and per-date queries") {
+        std::vector<std::pair<year_month_day, std::string>> expected;
+        for (int y = 2019; y <= 2026; ++y) {
+            for (const auto& date : calendar.getHolidays(y)) {
+                for (const auto& name : calendar.getHolidayNames(date)) {
+                    expected.emplace_back(date, name);
+                }
+            }
+        }
+        std::vector<std::pair<year_month_day, std::string>> holidays;
+        for (const auto& holiday : collect(year_month_day{year{2019}, month{1}, day{1}},
+                                           year_month_day{year{2027}, month{1}, day{1}})) {
+            holidays.emplace_back(holiday.date, holiday.name);
+        }
+        REQUIRE(holidays == expected);
+    }
+
+    SECTION("Names on a shared date: rules first, then explicit holidays") {
+        // Thanksgiving 2021 is November 25th
+        REQUIRE(collect(year_month_day{year{2021}, month{11}, day{25}},
+                        year_month_day{year{2021}, month{11}, day{26}}) ==
+                std::vector<datelib::Holiday>{
+                    holiday(year_month_day{year{2021}, month{11}, day{25}}, "Thanksgiving"),
+                    holiday(year_month_day{year{2021}, month{11}, day{25}}, "Day of Giving"),
+                    holiday(year_month_day{year{2021}, month{11}, day{25}}, "Harvest Festival")});
+    }
+
+    SECTION("Bounds are half-open and may split a year") {
+        // New Year's Day 2022 is observed on Friday, December 31st, 2021
+        REQUIRE(collect(year_month_day{year{2021}, month{12}, day{25}},
+                        year_month_day{year{2022}, month{1}, day{10}}) ==
+                std::vector<datelib::Holiday>{
+                    holiday(year_month_day{year{2021}, month{12}, day{25}}, "Christmas"),
+                    holiday(year_month_day{year{2021}, month{12}, day{31}}, "New Year's Day")});
+        REQUIRE(collect(year_month_day{year{2021}, month{12}, day{26}},
+                        year_month_day{year{2021}, month{12}, day{31}})
+                    .empty());
+        REQUIRE(collect(year_month_day{year{2022}, month{1}, day{1}},
+                        year_month_day{year{2021}, month{1}, day{1}})
+                    .empty());
+    }
+
+    SECTION("Name IDs of a date") {
+        std::vector<std::uint32_t> ids;
+        calendar.getHolidayNameIds(year_month_day{year{2021}, month{11}, day{25}},
+                                   std::back_inserter(ids));
+        REQUIRE(ids == std::vector<std::uint32_t>{datelib::internHolidayName("Thanksgiving"),
+                                                  datelib::internHolidayName("Day of Giving"),
+                                                  datelib::internHolidayName("Harvest Festival")});
+
+        ids.clear();
+        calendar.getHolidayNameIds(year_month_day{year{2021}, month{11}, day{26}},
+                                   std::back_inserter(ids));
+        calendar.getHolidayNameIds(year_month_day{year{2021}, month{2}, day{30}},
+                                   std::back_inserter(ids));
+        REQUIRE(ids.empty());
+    }
+
+    SECTION("Output iterator") {
+        std::vector<datelib::Holiday> holidays(4);
+        auto end = calendar.getHolidays(year_month_day{year{2024}, month{1}, day{1}},
+                                        year_month_day{year{2025}, month{1}, day{1}},
+                                        holidays.begin());
+        REQUIRE(end == holidays.end());
+        REQUIRE(holidays.front() ==
+                holiday(year_month_day{year{2024}, month{1}, day{1}}, "New Year's Day"));
+        REQUIRE(holidays.back() ==
+                holiday(year_month_day{year{2024}, month{12}, day{25}}, "Christmas"));
+    }
+
+    SECTION("More rule dates in a year than fit on the stack") {
+        // Two rules on each day of January and February, added from the last day to the first
+        datelib::HolidayCalendar busy;
+        for (int d = 59; d >= 1; --d) {
+            const year_month_day date{sys_days{year{2025} / 1 / 1} + days{d - 1}};
+            const auto month_day = static_cast<unsigned>(date.day());
+            busy.addRule(std::make_unique<datelib::FixedDateRule>(
+                "A" + std::to_string(d), static_cast<unsigned>(date.month()), month_day));
+            busy.addRule(std::make_unique<datelib::FixedDateRule>(
+                "B" + std::to_string(d), static_cast<unsigned>(date.month()), month_day));
+        }
+
+        std::vector<std::string> names;
+        busy.forEachHoliday(year_month_day{year{2024}, month{1}, day{1}},
+                            year_month_day{year{2026}, month{1}, day{1}},
+                            [&](const datelib::Holiday& h) { names.emplace_back(h.name); });
+        REQUIRE(names.size() == 2 * 2 * 59);
+        REQUIRE(names[0] == "A1");
+        REQUIRE(names[1] == "B1");
+        REQUIRE(names[2] == "A2");
+        REQUIRE(names[117] == "B59");
+        REQUIRE(names[118] == "A1");
+    }
+
+    SECTION("Invalid dates") {
+        REQUIRE_THROWS_AS(collect(year_month_day{year{2024}, month{2}, day{30}},
+                                  year_month_day{year{2025}, month{1}, day{1}}),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("HolidayCalendar with observed rules", "[HolidayCalendar]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::ObservedRule>(
+        std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1)));
+    calendar.addRule(std::make_unique<datelib::ObservedRule>(
+        std::make_unique<datelib::FixedDateRule>("New Year's Eve", 12, 31),
+        datelib::NEXT_MONDAY_OBSERVANCE));
+
+    // January 1st, 2022 is a Saturday, observed on Friday, December 31st, 2021
+    year_month_day into_previous{year{2021}, month{12}, day{31}};
+    // December 31st, 2022 is a Saturday, observed on Monday, January 2nd, 2023
+    year_month_day into_next{year{2023}, month{1}, day{2}};
+
+    SECTION("Observed dates spill into the adjacent years") {
+        REQUIRE(calendar.isHoliday(into_previous));
+        REQUIRE(calendar.isHoliday(into_next));
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2022}, month{1}, day{1}}));
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2022}, month{12}, day{31}}));
+
+        REQUIRE(calendar.getHolidays(2021).back() == into_previous);
+        REQUIRE(calendar.getHolidays(2022).empty());
+        REQUIRE(calendar.getHolidays(2023) == std::vector<year_month_day>{into_next});
+    }
+
+    SECTION("Names of observed holidays") {
+        REQUIRE(calendar.getHolidayNames(into_previous) ==
+                std::vector<std::string>{"New Year's Day", "New Year's Eve"});
+        REQUIRE(calendar.getHolidayNames(into_next) ==
+                std::vector<std::string>{"New Year's Day", "New Year's Eve"});
+    }
+
+    SECTION("Frozen calendars agree") {
+        auto compiled = calendar.freeze(2020, 2030);
+        for (int y = 2020; y <= 2030; ++y) {
+            REQUIRE(compiled.getHolidays(y) == calendar.getHolidays(y));
+        }
+        REQUIRE(compiled.getHolidayNames(into_next) ==
+                std::vector<std::string>{"New Year's Day", "New Year's Eve"});
+    }
+}
+
 TEST_CASE("HolidayCalendar copy operations", "[HolidayCalendar]") {
     datelib::HolidayCalendar calendar1;
     calendar1.addHoliday("July 4th", year_month_day{year{2024}, month{7}, day{4}});
@@ -198,3 +450,248 @@ TEST_CASE("Real-world US holidays example", "[HolidayCalendar]") {
         REQUIRE(names[0] == "Thanksgiving");
     }
 }
+
+namespace {
+// Rule that counts how many times it is evaluated, to observe the per-year cache
+class CountingRule : public datelib::HolidayRule {
+  public:
+    explicit CountingRule(int* evaluations) : evaluations_(evaluations) {}
+
+    bool appliesTo(int /*year*/) const override { return true; }
+    year_month_day calculateDate(int year) const override {
+        ++*evaluations_;
+        return year_month_day{std::chrono::year{year}, month{3}, day{1}};
+    }
+    std::string getName() const override { return "Counted"; }
+    std::unique_ptr<datelib::HolidayRule> clone() const override {
+        return std::make_unique<CountingRule>(evaluations_);
+    }
+
+  private:
+    int* evaluations_;
+};
+
+// Built-in rule with an overridden member, which must not be evaluated as a plain FixedDateRule
+class ShiftedFixedDateRule : public datelib::FixedDateRule {
+  public:
+    using FixedDateRule::FixedDateRule;
+
+    year_month_day calculateDate(int year) const override {
+        return year_month_day{sys_days{FixedDateRule::calculateDate(year)} + days{1}};
+    }
+    std::unique_ptr<datelib::HolidayRule> clone() const override {
+        return std::make_unique<ShiftedFixedDateRule>(*this);
+    }
+};
+} // namespace
+
+TEST_CASE("HolidayCalendar rule storage", "[HolidayCalendar]") {
+    datelib::HolidayCalendar calendar;
+
+    SECTION("Mixed built-in and custom rules keep their order") {
+        int evaluations = 0;
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Fixed", 3, 1));
+        calendar.addRule(std::make_unique<CountingRule>(&evaluations));
+        calendar.addRule(std::make_unique<datelib::NthWeekdayRule>("Nth", 3, 5,
+                                                                   datelib::Occurrence::First));
+        calendar.addRule(std::make_unique<datelib::ExplicitDateRule>(
+            "Explicit", year_month_day{year{2024}, month{3}, day{1}}));
+
+        // Friday, March 1, 2024 is the first Friday of March
+        REQUIRE(calendar.getHolidayNames(year_month_day{year{2024}, month{3}, day{1}}) ==
+                std::vector<std::string>{"Fixed", "Counted", "Nth", "Explicit"});
+        REQUIRE(calendar.getHolidays(2025).size() == 2);
+        REQUIRE(evaluations > 0);
+    }
+
+    SECTION("Classes derived from built-in rules keep their overrides") {
+        calendar.addRule(std::make_unique<ShiftedFixedDateRule>("Day After Christmas", 12, 25));
+
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{26}}));
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+    }
+
+    SECTION("Null rule") {
+        REQUIRE_THROWS_AS(calendar.addRule(nullptr), std::invalid_argument);
+    }
+}
+
+TEST_CASE("HolidayCalendar copy-on-write", "[HolidayCalendar]") {
+    datelib::HolidayCalendar original;
+    original.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+
+    SECTION("Changing a copy leaves the original unchanged") {
+        auto copy = original;
+        copy.addHoliday("Eclipse Day", year_month_day{year{2024}, month{4}, day{8}});
+
+        REQUIRE(copy.isHoliday(year_month_day{year{2024}, month{4}, day{8}}));
+        REQUIRE(copy.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+        REQUIRE_FALSE(original.isHoliday(year_month_day{year{2024}, month{4}, day{8}}));
+    }
+
+    SECTION("Changing the original leaves a copy unchanged") {
+        datelib::HolidayCalendar copy;
+        copy = original;
+        REQUIRE(copy.getHolidays(2024).size() == 1);
+
+        original.addRule(std::make_unique<datelib::FixedDateRule>("Boxing Day", 12, 26));
+
+        REQUIRE(original.getHolidays(2024).size() == 2);
+        REQUIRE(copy.getHolidays(2024).size() == 1);
+        REQUIRE_FALSE(copy.isHoliday(year_month_day{year{2024}, month{12}, day{26}}));
+    }
+
+    SECTION("Copies of copies are independent") {
+        auto first = original;
+        auto second = first;
+        first.addHoliday("First", year_month_day{year{2024}, month{1}, day{2}});
+        second.addHoliday("Second", year_month_day{year{2024}, month{1}, day{3}});
+
+        REQUIRE(original.getHolidays(2024).size() == 1);
+        REQUIRE(first.getHolidayNames(year_month_day{year{2024}, month{1}, day{2}}).size() == 1);
+        REQUIRE_FALSE(first.isHoliday(year_month_day{year{2024}, month{1}, day{3}}));
+        REQUIRE(second.isHoliday(year_month_day{year{2024}, month{1}, day{3}}));
+        REQUIRE_FALSE(second.isHoliday(year_month_day{year{2024}, month{1}, day{2}}));
+    }
+
+    SECTION("Moved-from calendar is empty and usable") {
+        auto moved = std::move(original);
+        REQUIRE(moved.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+
+        REQUIRE(original.getHolidays(2024).empty());
+        original.addHoliday("Eclipse Day", year_month_day{year{2024}, month{4}, day{8}});
+        REQUIRE(original.isHoliday(year_month_day{year{2024}, month{4}, day{8}}));
+        REQUIRE_FALSE(moved.isHoliday(year_month_day{year{2024}, month{4}, day{8}}));
+    }
+}
+
+TEST_CASE("HolidayCalendar per-year cache", "[HolidayCalendar][cache]") {
+    datelib::HolidayCalendar calendar;
+
+    SECTION("Rules are evaluated once per year") {
+        int evaluations = 0;
+        calendar.addRule(std::make_unique<CountingRule>(&evaluations));
+
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{3}, day{1}}));
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2024}, month{3}, day{2}}));
+        REQUIRE(calendar.getHolidays(2024).size() == 1);
+        REQUIRE(calendar.getHolidayNames(year_month_day{year{2024}, month{3}, day{1}}).size() == 1);
+        REQUIRE(evaluations == 2); // One cache build plus one name lookup
+
+        REQUIRE(calendar.isHoliday(year_month_day{year{2025}, month{3}, day{1}}));
+        REQUIRE(evaluations == 3);
+    }
+
+    SECTION("Adding a rule invalidates cached years") {
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+        REQUIRE(calendar.getHolidays(2024).size() == 1);
+    }
+
+    SECTION("Adding a holiday invalidates cached years") {
+        REQUIRE(calendar.getHolidays(2024).empty());
+
+        calendar.addHoliday("Eclipse Day", year_month_day{year{2024}, month{4}, day{8}});
+
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{4}, day{8}}));
+        REQUIRE(calendar.getHolidays(2024).size() == 1);
+    }
+
+    SECTION("Copy assignment replaces cached years") {
+        datelib::HolidayCalendar other;
+        other.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Boxing Day", 12, 26));
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{26}}));
+
+        calendar = other;
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{26}}));
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+    }
+
+    SECTION("Move assignment replaces cached years") {
+        datelib::HolidayCalendar other;
+        other.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Boxing Day", 12, 26));
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{26}}));
+
+        calendar = std::move(other);
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{26}}));
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{25}}));
+    }
+
+    SECTION("Copies share cached years") {
+        int evaluations = 0;
+        calendar.addRule(std::make_unique<CountingRule>(&evaluations));
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{3}, day{1}}));
+        REQUIRE(evaluations == 1);
+
+        datelib::HolidayCalendar copy(calendar);
+        REQUIRE(copy.isHoliday(year_month_day{year{2024}, month{3}, day{1}}));
+        REQUIRE(evaluations == 1);
+    }
+
+    SECTION("Years far from the present are cached too") {
+        int evaluations = 0;
+        calendar.addRule(std::make_unique<CountingRule>(&evaluations));
+
+        for (int y : {1600, 1899, 2299, 2300, 9999}) {
+            REQUIRE(calendar.isHoliday(year_month_day{year{y}, month{3}, day{1}}));
+            REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{y}, month{3}, day{2}}));
+        }
+        REQUIRE(evaluations == 5);
+    }
+
+    SECTION("Cached bitmaps are returned by reference") {
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+        const auto& bitmap = calendar.getHolidayBitmap(2024);
+        REQUIRE(&calendar.getHolidayBitmap(2024) == &bitmap);
+        REQUIRE(bitmap.count() == 1);
+    }
+
+    SECTION("Concurrent queries build each year once") {
+        int evaluations = 0;
+        calendar.addRule(std::make_unique<CountingRule>(&evaluations));
+
+        constexpr int THREADS = 4;
+        std::vector<int> holidays(THREADS);
+        {
+            std::vector<std::jthread> threads;
+            for (auto& count : holidays) {
+                // Each thread queries its own copy, sharing the cache
+                threads.emplace_back([&count, copy = calendar] {
+                    for (int y = 2000; y < 2050; ++y) {
+                        count += copy.isHoliday(year_month_day{year{y}, month{3}, day{1}}) ? 1 : 0;
+                    }
+                });
+            }
+        }
+
+        REQUIRE(evaluations == 50);
+        REQUIRE(holidays == std::vector<int>(THREADS, 50));
+    }
+
+    SECTION("Leap day and last day of a leap year") {
+        calendar.addHoliday("Leap Day", year_month_day{year{2024}, month{2}, day{29}});
+        calendar.addHoliday("New Year's Eve", year_month_day{year{2024}, month{12}, day{31}});
+
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{2}, day{29}}));
+        REQUIRE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{31}}));
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2024}, month{12}, day{30}}));
+
+        auto holidays = calendar.getHolidays(2024);
+        REQUIRE(holidays.size() == 2);
+        REQUIRE(holidays[1] == year_month_day{year{2024}, month{12}, day{31}});
+    }
+
+    SECTION("Invalid dates are never holidays") {
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Leap Day", 2, 29));
+
+        REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2023}, month{2}, day{30}}));
+        REQUIRE(calendar.getHolidayNames(year_month_day{year{2023}, month{2}, day{30}}).empty());
+    }
+}
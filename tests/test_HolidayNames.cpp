@@ -0,0 +1,68 @@
+#include "datelib/HolidayNames.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("Holiday name table", "[HolidayNames]") {
+    SECTION("Equal names share an ID") {
+        auto id = datelib::internHolidayName("Boxing Day");
+        std::string copy = "Boxing Day";
+        REQUIRE(datelib::internHolidayName(copy) == id);
+        REQUIRE(datelib::internHolidayName("Boxing Day ") != id);
+        REQUIRE(datelib::holidayName(id) == "Boxing Day");
+    }
+
+    SECTION("Names outlive the strings they were interned from") {
+        std::uint32_t id = 0;
+        {
+            std::string name(100, 'x');
+            id = datelib::internHolidayName(name);
+        }
+        REQUIRE(datelib::holidayName(id) == std::string(100, 'x'));
+    }
+
+    SECTION("The empty name is a name") {
+        auto id = datelib::internHolidayName("");
+        REQUIRE(datelib::holidayName(id).empty());
+    }
+
+    SECTION("Unknown IDs") {
+        auto count = datelib::holidayNameCount();
+        REQUIRE(count > 0);
+        REQUIRE_THROWS_AS(datelib::holidayName(static_cast<std::uint32_t>(count)),
+                          std::out_of_range);
+    }
+}
+
+TEST_CASE("Holiday name table across threads", "[HolidayNames]") {
+    constexpr int THREADS = 4;
+    constexpr int NAMES = 3000;
+
+    // Every thread interns the same names, enough to fill several blocks of the table, and reads
+    // each back as soon as it has its ID
+    std::vector<std::vector<std::uint32_t>> ids(THREADS, std::vector<std::uint32_t>(NAMES));
+    std::vector<int> mismatches(THREADS);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < NAMES; ++i) {
+                    auto name = "Threaded holiday " + std::to_string(i);
+                    auto id = datelib::internHolidayName(name);
+                    ids[t][i] = id;
+                    mismatches[t] += datelib::holidayName(id) == name ? 0 : 1;
+                }
+            });
+        }
+    }
+
+    for (int t = 0; t < THREADS; ++t) {
+        REQUIRE(mismatches[t] == 0);
+        REQUIRE(ids[t] == ids[0]);
+    }
+}
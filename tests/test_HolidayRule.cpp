@@ -1,4 +1,5 @@
 #include "datelib/HolidayRule.h"
+#include "datelib/exceptions.h"
 
 #include <stdexcept>
 
@@ -142,6 +143,144 @@ TEST_CASE("NthWeekdayRule calculates correct dates", "[HolidayRule]") {
     }
 }
 
+namespace {
+// Rule implementing only the two-step interface, to exercise the default tryCalculate
+class LeapYearOnlyRule : public datelib::HolidayRule {
+  public:
+    bool appliesTo(int year) const override { return year % 4 == 0; }
+    year_month_day calculateDate(int year) const override {
+        if (year == 2000) {
+            throw std::runtime_error("Unsupported year");
+        }
+        return year_month_day{std::chrono::year{year}, month{2}, day{29}};
+    }
+    std::string getName() const override { return "Leap Day"; }
+    std::unique_ptr<datelib::HolidayRule> clone() const override {
+        return std::make_unique<LeapYearOnlyRule>(*this);
+    }
+};
+} // namespace
+
+TEST_CASE("EasterOffsetRule construction", "[HolidayRule]") {
+    SECTION("Valid Easter offset rules") {
+        REQUIRE_NOTHROW(datelib::EasterOffsetRule("Good Friday", -2));
+        REQUIRE_NOTHROW(
+            datelib::EasterOffsetRule("Orthodox Easter", 0, datelib::EasterType::Orthodox));
+        REQUIRE_NOTHROW(datelib::EasterOffsetRule("Far", 366));
+    }
+
+    SECTION("Invalid parameters") {
+        REQUIRE_THROWS_AS(datelib::EasterOffsetRule("Too far", 367), std::invalid_argument);
+        REQUIRE_THROWS_AS(datelib::EasterOffsetRule("Too far", -367), std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            datelib::EasterOffsetRule("Bad type", 0, static_cast<datelib::EasterType>(2)),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("EasterOffsetRule calculates correct dates", "[HolidayRule]") {
+    using datelib::EasterType;
+
+    SECTION("Western Easter") {
+        datelib::EasterOffsetRule easter("Easter Sunday", 0);
+        REQUIRE(easter.calculateDate(2024) == year_month_day{year{2024}, month{3}, day{31}});
+        REQUIRE(easter.calculateDate(2025) == year_month_day{year{2025}, month{4}, day{20}});
+        REQUIRE(easter.calculateDate(2000) == year_month_day{year{2000}, month{4}, day{23}});
+        // Earliest and latest possible dates
+        REQUIRE(easter.calculateDate(1818) == year_month_day{year{1818}, month{3}, day{22}});
+        REQUIRE(easter.calculateDate(2038) == year_month_day{year{2038}, month{4}, day{25}});
+        REQUIRE(easter.getName() == "Easter Sunday");
+    }
+
+    SECTION("Orthodox Easter") {
+        datelib::EasterOffsetRule easter("Orthodox Easter", 0, EasterType::Orthodox);
+        REQUIRE(easter.calculateDate(2021) == year_month_day{year{2021}, month{5}, day{2}});
+        REQUIRE(easter.calculateDate(2023) == year_month_day{year{2023}, month{4}, day{16}});
+        REQUIRE(easter.calculateDate(2024) == year_month_day{year{2024}, month{5}, day{5}});
+        REQUIRE(easter.calculateDate(2025) == year_month_day{year{2025}, month{4}, day{20}});
+    }
+
+    SECTION("Offsets") {
+        REQUIRE(datelib::EasterOffsetRule("Good Friday", -2).calculateDate(2024) ==
+                year_month_day{year{2024}, month{3}, day{29}});
+        REQUIRE(datelib::EasterOffsetRule("Easter Monday", 1).calculateDate(2024) ==
+                year_month_day{year{2024}, month{4}, day{1}});
+        REQUIRE(datelib::EasterOffsetRule("Ascension Day", 39).calculateDate(2024) ==
+                year_month_day{year{2024}, month{5}, day{9}});
+        REQUIRE(datelib::EasterOffsetRule("Whit Monday", 50).calculateDate(2024) ==
+                year_month_day{year{2024}, month{5}, day{20}});
+        REQUIRE(datelib::EasterOffsetRule("Orthodox Good Friday", -2, EasterType::Orthodox)
+                    .calculateDate(2024) == year_month_day{year{2024}, month{5}, day{3}});
+    }
+
+    SECTION("Every tabulated Easter is a Sunday in spring") {
+        for (auto type : {EasterType::Western, EasterType::Orthodox}) {
+            datelib::EasterOffsetRule easter("Easter Sunday", 0, type);
+            for (int y = 1583; y <= 4099; ++y) {
+                auto date = easter.calculateDate(y);
+                REQUIRE(weekday{sys_days{date}} == Sunday);
+                REQUIRE(date >= year_month_day{year{y}, month{3}, day{22}});
+                REQUIRE(date <= year_month_day{year{y}, month{5}, day{31}});
+            }
+        }
+    }
+
+    SECTION("Years outside the tables or offsets leaving the year") {
+        datelib::EasterOffsetRule easter("Easter Sunday", 0);
+        REQUIRE_FALSE(easter.appliesTo(1582));
+        REQUIRE_FALSE(easter.appliesTo(4100));
+        REQUIRE_THROWS_AS(easter.calculateDate(1582), datelib::DateNotInYearException);
+
+        datelib::EasterOffsetRule before("Before", -100);
+        REQUIRE_FALSE(before.tryCalculate(2024).has_value());
+        REQUIRE(datelib::EasterOffsetRule("After", 270).tryCalculate(2024) ==
+                year_month_day{year{2024}, month{12}, day{26}});
+    }
+}
+
+TEST_CASE("HolidayRule tryCalculate", "[HolidayRule]") {
+    SECTION("ExplicitDateRule") {
+        datelib::ExplicitDateRule rule("Eclipse", year_month_day{year{2024}, month{4}, day{8}});
+        REQUIRE(rule.tryCalculate(2024) == year_month_day{year{2024}, month{4}, day{8}});
+        REQUIRE_FALSE(rule.tryCalculate(2025).has_value());
+    }
+
+    SECTION("FixedDateRule") {
+        datelib::FixedDateRule rule("Leap Day", 2, 29);
+        REQUIRE(rule.tryCalculate(2024) == year_month_day{year{2024}, month{2}, day{29}});
+        REQUIRE_FALSE(rule.tryCalculate(2023).has_value());
+    }
+
+    SECTION("NthWeekdayRule") {
+        datelib::NthWeekdayRule fifth_monday("Fifth Monday", 9, 1, datelib::Occurrence::Fifth);
+        // September 2024 has five Mondays (2, 9, 16, 23, 30); September 2023 has four
+        REQUIRE(fifth_monday.tryCalculate(2024) == year_month_day{year{2024}, month{9}, day{30}});
+        REQUIRE_FALSE(fifth_monday.tryCalculate(2023).has_value());
+
+        datelib::NthWeekdayRule memorial_day("Memorial Day", 5, 1, datelib::Occurrence::Last);
+        REQUIRE(memorial_day.tryCalculate(2024) == year_month_day{year{2024}, month{5}, day{27}});
+    }
+
+    SECTION("Agrees with appliesTo and calculateDate") {
+        datelib::NthWeekdayRule rule("Fifth Friday", 1, 5, datelib::Occurrence::Fifth);
+        for (int y = 1990; y < 2040; ++y) {
+            auto date = rule.tryCalculate(y);
+            REQUIRE(date.has_value() == rule.appliesTo(y));
+            if (date) {
+                REQUIRE(*date == rule.calculateDate(y));
+            }
+        }
+    }
+
+    SECTION("Default implementation for custom rules") {
+        LeapYearOnlyRule rule;
+        REQUIRE(rule.tryCalculate(2024) == year_month_day{year{2024}, month{2}, day{29}});
+        REQUIRE_FALSE(rule.tryCalculate(2023).has_value());
+        // Exceptions from calculateDate are reported as no date
+        REQUIRE_FALSE(rule.tryCalculate(2000).has_value());
+    }
+}
+
 TEST_CASE("HolidayRule clone", "[HolidayRule]") {
     SECTION("ExplicitDateRule clone") {
         year_month_day ymd{year{2024}, month{10}, day{31}};
@@ -169,6 +308,128 @@ TEST_CASE("HolidayRule clone", "[HolidayRule]") {
     }
 }
 
+TEST_CASE("EasterOffsetRule clone", "[HolidayRule]") {
+    datelib::EasterOffsetRule original("Whit Monday", 50, datelib::EasterType::Orthodox);
+    auto cloned = original.clone();
+    REQUIRE(cloned->getName() == "Whit Monday");
+    REQUIRE(cloned->calculateDate(2024) == original.calculateDate(2024));
+}
+
+namespace {
+class RenamedFixedDateRule : public datelib::FixedDateRule {
+  public:
+    using FixedDateRule::FixedDateRule;
+
+    std::string getName() const override { return "Renamed " + FixedDateRule::getName(); }
+};
+} // namespace
+
+TEST_CASE("HolidayRule name IDs", "[HolidayRule]") {
+    datelib::FixedDateRule christmas("Christmas", 12, 25);
+    datelib::NthWeekdayRule thanksgiving("Thanksgiving", 11, 4, datelib::Occurrence::Fourth);
+
+    SECTION("Built-in rules intern their names") {
+        REQUIRE(christmas.getNameId() == datelib::internHolidayName("Christmas"));
+        REQUIRE(datelib::holidayName(thanksgiving.getNameId()) == "Thanksgiving");
+        REQUIRE(christmas.clone()->getNameId() == christmas.getNameId());
+        REQUIRE(datelib::EasterOffsetRule("Christmas", 0).getNameId() == christmas.getNameId());
+    }
+
+    SECTION("Observed rules keep the name of the rule they wrap") {
+        datelib::ObservedRule observed(std::make_unique<datelib::FixedDateRule>(christmas));
+        REQUIRE(observed.getNameId() == christmas.getNameId());
+    }
+
+    SECTION("A derived rule renaming the holiday gets the ID of its own name") {
+        RenamedFixedDateRule renamed("Christmas", 12, 25);
+        REQUIRE(datelib::holidayName(renamed.getNameId()) == "Renamed Christmas");
+    }
+}
+
+TEST_CASE("Observance", "[HolidayRule]") {
+    SECTION("The default observance moves nothing") {
+        datelib::Observance observance;
+        year_month_day saturday{year{2022}, month{1}, day{1}};
+        REQUIRE(observance.apply(saturday) == saturday);
+        REQUIRE(observance.shiftFor(Saturday) == 0);
+    }
+
+    SECTION("Shifts are per weekday and may cross a year boundary") {
+        constexpr auto observance = datelib::NEAREST_WEEKDAY_OBSERVANCE;
+        STATIC_REQUIRE(observance.shiftFor(Saturday) == -1);
+        STATIC_REQUIRE(observance.shiftFor(Sunday) == 1);
+        STATIC_REQUIRE(observance.apply(year_month_day{year{2022}, month{1}, day{1}}) ==
+                       year_month_day{year{2021}, month{12}, day{31}});
+        REQUIRE(observance.apply(year_month_day{year{2022}, month{12}, day{25}}) ==
+                year_month_day{year{2022}, month{12}, day{26}});
+        REQUIRE(observance.apply(year_month_day{year{2024}, month{12}, day{25}}) ==
+                year_month_day{year{2024}, month{12}, day{25}});
+    }
+
+    SECTION("Predefined observances") {
+        // Christmas 2021 fell on a Saturday
+        year_month_day christmas{year{2021}, month{12}, day{25}};
+        REQUIRE(datelib::NEXT_MONDAY_OBSERVANCE.apply(christmas) ==
+                year_month_day{year{2021}, month{12}, day{27}});
+        REQUIRE(datelib::SUNDAY_TO_MONDAY_OBSERVANCE.apply(christmas) == christmas);
+    }
+
+    SECTION("Invalid shifts") {
+        datelib::Observance observance;
+        REQUIRE_THROWS_WITH(observance.with(Sunday, 7),
+                            "Observance shift must be between -6 and 6 days");
+        REQUIRE_THROWS_WITH(observance.with(Sunday, -7),
+                            "Observance shift must be between -6 and 6 days");
+        REQUIRE_THROWS_WITH(observance.with(weekday{8}, 1), "Weekday must be between 0 and 6");
+    }
+}
+
+TEST_CASE("ObservedRule calculates observed dates", "[HolidayRule]") {
+    datelib::ObservedRule rule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+
+    REQUIRE(rule.getName() == "New Year's Day");
+    REQUIRE(rule.observance() == datelib::NEAREST_WEEKDAY_OBSERVANCE);
+
+    SECTION("Weekday holidays are not moved") {
+        REQUIRE(rule.calculateDate(2024) == year_month_day{year{2024}, month{1}, day{1}});
+    }
+
+    SECTION("A Saturday holiday moves into the previous year") {
+        REQUIRE(rule.calculateDate(2022) == year_month_day{year{2021}, month{12}, day{31}});
+        REQUIRE(rule.tryCalculate(2022) == year_month_day{year{2021}, month{12}, day{31}});
+    }
+
+    SECTION("A Sunday holiday moves to Monday") {
+        REQUIRE(rule.calculateDate(2023) == year_month_day{year{2023}, month{1}, day{2}});
+    }
+
+    SECTION("Years the wrapped rule does not apply to") {
+        datelib::ObservedRule leap_day(std::make_unique<datelib::FixedDateRule>("Leap Day", 2, 29));
+        REQUIRE(leap_day.appliesTo(2024));
+        REQUIRE_FALSE(leap_day.appliesTo(2023));
+        REQUIRE_FALSE(leap_day.tryCalculate(2023).has_value());
+        REQUIRE_THROWS_AS(leap_day.calculateDate(2023), datelib::InvalidDateException);
+    }
+
+    SECTION("Custom observance") {
+        datelib::ObservedRule next_monday(
+            std::make_unique<datelib::FixedDateRule>("Boxing Day", 12, 26),
+            datelib::NEXT_MONDAY_OBSERVANCE);
+        // December 26th, 2021 was a Sunday
+        REQUIRE(next_monday.calculateDate(2021) == year_month_day{year{2021}, month{12}, day{27}});
+    }
+
+    SECTION("Clones share the wrapped rule") {
+        auto cloned = rule.clone();
+        REQUIRE(cloned->getName() == "New Year's Day");
+        REQUIRE(cloned->calculateDate(2022) == rule.calculateDate(2022));
+    }
+
+    SECTION("Null rule") {
+        REQUIRE_THROWS_WITH(datelib::ObservedRule(nullptr), "Rule must not be null");
+    }
+}
+
 TEST_CASE("HolidayRule polymorphic destruction", "[HolidayRule]") {
     SECTION("Delete through base class pointer") {
         // Test virtual destructor by deleting through base class pointer
@@ -0,0 +1,125 @@
+#include "datelib/JointCalendar.h"
+#include "datelib/date.h"
+
+#include <stdexcept>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+namespace {
+datelib::HolidayCalendar makeDubai() {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("National Day", 12, 2));
+    calendar.addHoliday("Eid al-Fitr", year{2024} / April / 10);
+    return calendar;
+}
+} // namespace
+
+TEST_CASE("JointCalendar combines business days", "[JointCalendar]") {
+    using enum datelib::BusinessDayConvention;
+    auto new_york = makeUsCalendar();
+    auto dubai = makeDubai();
+
+    datelib::JointCalendar both(datelib::JoinRule::JoinHolidays);
+    both.add(new_york);
+    both.add(dubai, datelib::FRIDAY_SATURDAY_WEEKEND);
+    datelib::JointCalendar either(datelib::JoinRule::JoinBusinessDays);
+    either.add(new_york);
+    either.add(dubai, datelib::FRIDAY_SATURDAY_WEEKEND);
+
+    REQUIRE(both.size() == 2);
+    REQUIRE(either.rule() == datelib::JoinRule::JoinBusinessDays);
+
+    auto start = sys_days{year{2023} / December / 1};
+    for (auto d = start; d < sys_days{year{2025} / February / 1}; d += days{1}) {
+        year_month_day date{d};
+        bool in_new_york = datelib::isBusinessDay(date, new_york);
+        bool in_dubai = datelib::isBusinessDay(date, dubai, datelib::FRIDAY_SATURDAY_WEEKEND);
+
+        REQUIRE(datelib::isBusinessDay(date, both) == (in_new_york && in_dubai));
+        REQUIRE(datelib::isBusinessDay(date, either) == (in_new_york || in_dubai));
+    }
+
+    SECTION("adjust walks the joint business days") {
+        // Friday 2024-04-05 is closed in Dubai; Monday 2024-04-08 is open in both
+        REQUIRE(datelib::adjust(year{2024} / April / 5, Following, both) ==
+                year{2024} / April / 8);
+        REQUIRE(datelib::adjust(year{2024} / April / 5, Following, either) ==
+                year{2024} / April / 5);
+        // Eid on Wednesday 2024-04-10
+        REQUIRE(datelib::adjust(year{2024} / April / 10, Preceding, both) ==
+                year{2024} / April / 9);
+        // New Year's Day is closed in both; Sunday 2023-12-31 is open in Dubai
+        REQUIRE(datelib::adjust(year{2024} / January / 1, Preceding, either) ==
+                year{2023} / December / 31);
+        REQUIRE(datelib::adjust(year{2024} / January / 1, ModifiedPreceding, either) ==
+                year{2024} / January / 2);
+    }
+
+    SECTION("Later changes to a calendar do not affect the joint calendar") {
+        new_york.addHoliday("Closure", year{2024} / April / 9);
+        REQUIRE(datelib::isBusinessDay(year{2024} / April / 9, both));
+    }
+}
+
+TEST_CASE("JointCalendar cached years", "[JointCalendar]") {
+    datelib::JointCalendar joint;
+    joint.add(makeUsCalendar());
+    // Fills the cache for 2024
+    REQUIRE(datelib::isBusinessDay(year{2024} / December / 2, joint));
+
+    SECTION("Adding a calendar discards cached years") {
+        joint.add(makeDubai(), datelib::FRIDAY_SATURDAY_WEEKEND);
+        REQUIRE_FALSE(datelib::isBusinessDay(year{2024} / December / 2, joint));
+    }
+
+    SECTION("Copies share cached years until a calendar is added to one of them") {
+        auto copy = joint;
+        REQUIRE(copy.getBusinessDayBitmap(2024) == joint.getBusinessDayBitmap(2024));
+
+        copy.add(makeDubai(), datelib::FRIDAY_SATURDAY_WEEKEND);
+        REQUIRE_FALSE(datelib::isBusinessDay(year{2024} / December / 2, copy));
+        REQUIRE(datelib::isBusinessDay(year{2024} / December / 2, joint));
+        REQUIRE(copy.size() == 2);
+        REQUIRE(joint.size() == 1);
+    }
+}
+
+TEST_CASE("JointCalendar edge cases", "[JointCalendar]") {
+    using enum datelib::BusinessDayConvention;
+
+    SECTION("No calendars") {
+        datelib::JointCalendar joint;
+        REQUIRE(joint.rule() == datelib::JoinRule::JoinHolidays);
+        REQUIRE(datelib::isBusinessDay(year{2024} / December / 25, joint));
+        REQUIRE(joint.getBusinessDayBitmap(2024) == datelib::YearBitmap::allDays(2024));
+    }
+
+    SECTION("Single calendar matches the calendar itself") {
+        auto new_york = makeUsCalendar();
+        datelib::JointCalendar joint;
+        joint.add(new_york);
+        for (int y = 2023; y <= 2025; ++y) {
+            REQUIRE(joint.getBusinessDayBitmap(y) ==
+                    new_york.getBusinessDayBitmap(y, datelib::SATURDAY_SUNDAY_WEEKEND));
+        }
+    }
+
+    SECTION("Invalid dates") {
+        datelib::JointCalendar joint;
+        REQUIRE_THROWS_AS(datelib::isBusinessDay(year{2024} / February / 30, joint),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(datelib::adjust(year{2024} / February / 30, Following, joint),
+                          std::invalid_argument);
+    }
+
+    SECTION("No business day at all") {
+        datelib::JointCalendar joint;
+        joint.add(datelib::HolidayCalendar{}, datelib::WeekendMask::fromBits(0x7F));
+        REQUIRE_THROWS_AS(datelib::adjust(year{2024} / March / 1, Following, joint),
+                          datelib::BusinessDaySearchException);
+    }
+}
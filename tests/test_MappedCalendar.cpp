@@ -0,0 +1,201 @@
+#include "datelib/HolidayCalendar.h"
+#include "datelib/MappedCalendar.h"
+#include "datelib/date.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+namespace {
+/**
+ * @brief A file path in the temporary directory, removed when the test ends
+ */
+class TemporaryFile {
+  public:
+    explicit TemporaryFile(const std::string& name)
+        : path_(std::filesystem::temp_directory_path() / ("datelib_test_" + name)) {}
+    ~TemporaryFile() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+    TemporaryFile(const TemporaryFile&) = delete;
+    TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+    const std::filesystem::path& path() const { return path_; }
+
+  private:
+    std::filesystem::path path_;
+};
+
+std::string readBytes(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void writeBytes(const std::filesystem::path& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+} // namespace
+
+TEST_CASE("MappedCalendar matches the compiled calendar", "[MappedCalendar]") {
+    using enum datelib::BusinessDayConvention;
+    TemporaryFile file("matches.cal");
+    auto calendar = makeUsCalendarWithSharedDate();
+    auto compiled = calendar.freeze(2023, 2026);
+    datelib::writeCalendarFile(compiled, file.path());
+
+    datelib::MappedCalendar mapped(file.path());
+    REQUIRE(mapped.firstYear() == 2023);
+    REQUIRE(mapped.lastYear() == 2026);
+    REQUIRE(mapped.contains(year_month_day{year{2026}, month{12}, day{31}}));
+    REQUIRE_FALSE(mapped.contains(year_month_day{year{2027}, month{1}, day{1}}));
+
+    SECTION("Per-year queries") {
+        for (int y = 2023; y <= 2026; ++y) {
+            REQUIRE(mapped.getHolidays(y) == compiled.getHolidays(y));
+            REQUIRE(mapped.getHolidayBitmap(y) == compiled.getHolidayBitmap(y));
+            REQUIRE(mapped.getBusinessDayBitmap(y, datelib::FRIDAY_SATURDAY_WEEKEND) ==
+                    compiled.getBusinessDayBitmap(y, datelib::FRIDAY_SATURDAY_WEEKEND));
+        }
+    }
+
+    SECTION("Per-day queries") {
+        auto start = sys_days{year{2023} / January / 1};
+        for (auto d = start; d < sys_days{year{2027} / January / 1}; d += days{1}) {
+            year_month_day date{d};
+            REQUIRE(mapped.isHoliday(date) == compiled.isHoliday(date));
+            REQUIRE(mapped.getHolidayNames(date) == compiled.getHolidayNames(date));
+            REQUIRE(datelib::isBusinessDay(date, mapped) ==
+                    datelib::isBusinessDay(date, compiled));
+        }
+        auto names = mapped.getHolidayNames(year_month_day{year{2024}, month{12}, day{25}});
+        REQUIRE(names == std::vector<std::string>{"Christmas", "Founders Day"});
+        REQUIRE_FALSE(mapped.isHoliday(year_month_day{year{2024}, month{2}, day{30}}));
+    }
+
+    SECTION("adjust") {
+        auto start = sys_days{year{2024} / January / 1};
+        for (auto d = start; d < sys_days{year{2026} / January / 1}; d += days{1}) {
+            year_month_day date{d};
+            for (auto convention : {Following, ModifiedFollowing, Preceding, ModifiedPreceding}) {
+                REQUIRE(datelib::adjust(date, convention, mapped) ==
+                        datelib::adjust(date, convention, compiled));
+            }
+        }
+    }
+
+    SECTION("Outside the range") {
+        REQUIRE_THROWS_AS(mapped.isHoliday(year_month_day{year{2027}, month{1}, day{1}}),
+                          datelib::YearOutOfRangeException);
+        REQUIRE_THROWS_AS(mapped.getHolidays(2022), std::out_of_range);
+        REQUIRE_THROWS_AS(datelib::adjust(year_month_day{year{2023}, month{1}, day{1}},
+                                          Preceding, mapped),
+                          datelib::YearOutOfRangeException);
+        REQUIRE_THROWS_AS(datelib::isBusinessDay(year_month_day{year{2024}, month{2}, day{30}},
+                                                 mapped),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("MappedCalendar file format", "[MappedCalendar]") {
+    TemporaryFile file("format.cal");
+    datelib::writeCalendarFile(makeUsCalendarWithSharedDate().freeze(2024, 2025), file.path());
+    auto bytes = readBytes(file.path());
+
+    SECTION("Header is little-endian") {
+        REQUIRE(bytes.substr(0, 8) == "DATELIBC");
+        REQUIRE(bytes.size() % 8 == 0);
+        // Version 1 and first year 2024 (0x07E8)
+        REQUIRE(bytes.substr(8, 4) == std::string("\x01\x00\x00\x00", 4));
+        REQUIRE(bytes.substr(12, 4) == std::string("\xE8\x07\x00\x00", 4));
+    }
+
+    SECTION("Rejects files that are not calendar files") {
+        REQUIRE_THROWS_AS(datelib::MappedCalendar(file.path().string() + ".missing"),
+                          datelib::CalendarFileException);
+
+        writeBytes(file.path(), "not a calendar");
+        REQUIRE_THROWS_AS(datelib::MappedCalendar(file.path()), datelib::CalendarFileException);
+
+        auto wrong_magic = bytes;
+        wrong_magic[0] = 'X';
+        writeBytes(file.path(), wrong_magic);
+        REQUIRE_THROWS_AS(datelib::MappedCalendar(file.path()), datelib::CalendarFileException);
+    }
+
+    SECTION("Rejects unsupported versions") {
+        auto next_version = bytes;
+        next_version[8] = '\x02';
+        writeBytes(file.path(), next_version);
+        REQUIRE_THROWS_AS(datelib::MappedCalendar(file.path()), datelib::CalendarFileException);
+    }
+
+    SECTION("Rejects truncated files") {
+        writeBytes(file.path(), bytes.substr(0, bytes.size() - 8));
+        REQUIRE_THROWS_AS(datelib::MappedCalendar(file.path()), datelib::CalendarFileException);
+    }
+}
+
+TEST_CASE("MappedCalendar ownership", "[MappedCalendar]") {
+    TemporaryFile file("ownership.cal");
+    datelib::writeCalendarFile(makeUsCalendarWithSharedDate().freeze(2024, 2024), file.path());
+    const year_month_day christmas{year{2024}, month{12}, day{25}};
+
+    SECTION("Move keeps the mapping") {
+        datelib::MappedCalendar first(file.path());
+        datelib::MappedCalendar second(std::move(first));
+        REQUIRE(second.isHoliday(christmas));
+
+        datelib::MappedCalendar third(file.path());
+        third = std::move(second);
+        REQUIRE(third.isHoliday(christmas));
+    }
+
+    SECTION("Replacing the file does not affect open calendars") {
+        datelib::MappedCalendar mapped(file.path());
+        datelib::HolidayCalendar empty;
+        datelib::writeCalendarFile(empty.freeze(2030, 2030), file.path());
+
+        REQUIRE(mapped.isHoliday(christmas));
+        REQUIRE(mapped.getHolidayNames(christmas) ==
+                std::vector<std::string>{"Christmas", "Founders Day"});
+        REQUIRE(datelib::MappedCalendar(file.path()).firstYear() == 2030);
+    }
+}
+
+TEST_CASE("MappedCalendar concurrent writers", "[MappedCalendar]") {
+    auto directory = std::filesystem::temp_directory_path() / "datelib_test_writers";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+    auto path = directory / "us.cal";
+
+    const auto compiled = makeUsCalendar().freeze(2024, 2025);
+    {
+        std::vector<std::jthread> writers;
+        for (int i = 0; i < 4; ++i) {
+            writers.emplace_back([&] {
+                for (int round = 0; round < 8; ++round) {
+                    datelib::writeCalendarFile(compiled, path);
+                }
+            });
+        }
+    }
+
+    // Every writer used its own temporary file, so the last rename left a complete calendar and
+    // nothing else behind
+    const year_month_day christmas{year{2024}, month{12}, day{25}};
+    REQUIRE(datelib::MappedCalendar(path).isHoliday(christmas));
+    REQUIRE(std::distance(std::filesystem::directory_iterator(directory),
+                          std::filesystem::directory_iterator()) == 1);
+    std::filesystem::remove_all(directory);
+}
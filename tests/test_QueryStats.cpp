@@ -0,0 +1,147 @@
+#include "datelib/QueryStats.h"
+
+#include "datelib/HolidayCalendar.h"
+#include "datelib/date.h"
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+using namespace std::chrono;
+
+namespace {
+datelib::HolidayCalendar makeCalendar() {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::ObservedRule>(
+        std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25)));
+    return calendar;
+}
+
+std::uint64_t bucketTotal(const datelib::Histogram& histogram) {
+    return std::accumulate(histogram.buckets.begin(), histogram.buckets.end(), std::uint64_t{0});
+}
+} // namespace
+
+TEST_CASE("Histogram buckets", "[QueryStats]") {
+    STATIC_REQUIRE(datelib::Histogram::bucketLowerBound(0) == 0);
+    STATIC_REQUIRE(datelib::Histogram::bucketLowerBound(1) == 1);
+    STATIC_REQUIRE(datelib::Histogram::bucketLowerBound(2) == 2);
+    STATIC_REQUIRE(datelib::Histogram::bucketLowerBound(10) == 512);
+}
+
+TEST_CASE("Operation names", "[QueryStats]") {
+    REQUIRE(datelib::statsOperationName(datelib::StatsOperation::IsHoliday) == "isHoliday");
+    REQUIRE(datelib::statsOperationName(datelib::StatsOperation::AdjustModifiedFollowing) ==
+            "adjust.ModifiedFollowing");
+    REQUIRE(datelib::statsOperationName(datelib::StatsOperation::AdjustUnadjusted) ==
+            "adjust.Unadjusted");
+}
+
+TEST_CASE("Query statistics", "[QueryStats]") {
+    auto calendar = makeCalendar();
+    datelib::resetQueryStats();
+
+    // Christmas 2021 is a Saturday, observed on Friday the 24th
+    year_month_day christmas_eve{year{2021}, month{12}, day{24}};
+    year_month_day christmas{year{2021}, month{12}, day{25}};
+    REQUIRE(calendar.isHoliday(christmas_eve));
+    REQUIRE(calendar.getHolidays(2021).size() == 2);
+    REQUIRE_FALSE(datelib::isBusinessDay(christmas_eve, calendar));
+    REQUIRE(datelib::adjust(christmas, datelib::BusinessDayConvention::Following, calendar) ==
+            year_month_day{year{2021}, month{12}, day{27}});
+    REQUIRE(datelib::adjust(christmas, datelib::BusinessDayConvention::Preceding, calendar) ==
+            year_month_day{year{2021}, month{12}, day{23}});
+
+    auto stats = datelib::getQueryStats();
+
+    if (!datelib::queryStatsEnabled()) {
+        // Built without DATELIB_ENABLE_STATS: nothing is recorded
+        REQUIRE(stats == datelib::QueryStats{});
+        return;
+    }
+
+    SECTION("Calls are counted per operation") {
+        using enum datelib::StatsOperation;
+        // Direct call, then the lookups of isBusinessDay() and of the weekdays the adjustments
+        // examine (Monday the 27th, then Friday the 24th and Thursday the 23rd)
+        REQUIRE(stats.latency(IsHoliday).count == 1 + 1 + 1 + 2);
+        REQUIRE(stats.latency(GetHolidays).count == 1);
+        REQUIRE(stats.latency(IsBusinessDay).count == 1);
+        REQUIRE(stats.latency(AdjustFollowing).count == 1);
+        REQUIRE(stats.latency(AdjustPreceding).count == 1);
+        REQUIRE(stats.latency(AdjustModifiedFollowing).count == 0);
+
+        for (const auto& latency : stats.latencies) {
+            REQUIRE(bucketTotal(latency) == latency.count);
+            REQUIRE(latency.max <= latency.sum);
+        }
+    }
+
+    SECTION("Rule evaluations and cached years") {
+        // 2021 is built once; the observed rule is also evaluated for 2020 and 2022
+        REQUIRE(stats.year_bitmaps_built == 1);
+        REQUIRE(stats.rule_evaluations == 1 + 3);
+    }
+
+    SECTION("Days examined by adjustments") {
+        // Saturday to Monday past the weekend, Saturday back to Thursday past the observed day
+        REQUIRE(stats.search_days.count == 2);
+        REQUIRE(stats.search_days.sum == 3 + 3);
+        REQUIRE(stats.search_days.max == 3);
+        REQUIRE(stats.search_days.buckets[2] == 2);
+        REQUIRE(stats.search_limit_exceeded == 0);
+    }
+
+    SECTION("Searches reaching the limit") {
+        datelib::HolidayCalendar closed;
+        for (sys_days day = year{2023} / January / 1; day < year{2026} / January / 1;
+             day += days{1}) {
+            closed.addHoliday("Closed", year_month_day{day});
+        }
+        datelib::resetQueryStats();
+
+        REQUIRE_THROWS_AS(datelib::adjust(year_month_day{year{2024}, month{6}, day{15}},
+                                          datelib::BusinessDayConvention::Following, closed),
+                          datelib::BusinessDaySearchException);
+        stats = datelib::getQueryStats();
+        REQUIRE(stats.search_limit_exceeded == 1);
+        REQUIRE(stats.search_days.max == 367);
+        REQUIRE(stats.latency(datelib::StatsOperation::AdjustFollowing).count == 1);
+    }
+
+    SECTION("Reset") {
+        datelib::resetQueryStats();
+        REQUIRE(datelib::getQueryStats() == datelib::QueryStats{});
+    }
+}
+
+TEST_CASE("Query statistics across threads", "[QueryStats]") {
+    auto calendar = makeCalendar();
+    REQUIRE_FALSE(calendar.isHoliday(year_month_day{year{2021}, month{3}, day{1}}));
+    datelib::resetQueryStats();
+
+    constexpr int THREADS = 4;
+    constexpr int CALLS = 10000;
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < CALLS; ++i) {
+                    (void)calendar.isHoliday(year_month_day{year{2021}, month{3}, day{1}});
+                }
+            });
+        }
+    }
+
+    auto latency = datelib::getQueryStats().latency(datelib::StatsOperation::IsHoliday);
+    if (datelib::queryStatsEnabled()) {
+        REQUIRE(latency.count == THREADS * CALLS);
+        REQUIRE(bucketTotal(latency) == THREADS * CALLS);
+    } else {
+        REQUIRE(latency.count == 0);
+    }
+}
@@ -0,0 +1,253 @@
+#include "datelib/Schedule.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+namespace {
+/**
+ * @brief Generate one schedule into vectors of the exact size
+ */
+std::vector<sys_days> unadjustedDates(const datelib::ScheduleGenerator& generator,
+                                      const datelib::ScheduleSpec& spec) {
+    std::vector<sys_days> unadjusted(datelib::ScheduleGenerator::size(spec));
+    std::vector<sys_days> adjusted(unadjusted.size());
+    REQUIRE(generator.generate(spec, unadjusted, adjusted) == unadjusted.size());
+    return unadjusted;
+}
+
+std::vector<sys_days> dayList(std::initializer_list<year_month_day> dates) {
+    return {dates.begin(), dates.end()};
+}
+} // namespace
+
+TEST_CASE("ScheduleGenerator rolls regular dates", "[Schedule]") {
+    using enum datelib::StubRule;
+    datelib::ScheduleGenerator generator(makeUsCalendar(), 2020, 2030);
+
+    datelib::ScheduleSpec spec;
+    spec.start = year{2024} / February / 1;
+    spec.end = year{2025} / January / 15;
+    spec.tenor = months{3};
+
+    SECTION("Stubs at either end, short or long") {
+        spec.stub = ShortFront;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / February / 1, year{2024} / April / 15, year{2024} / July / 15,
+                         year{2024} / October / 15, year{2025} / January / 15}));
+
+        spec.stub = LongFront;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / February / 1, year{2024} / July / 15,
+                         year{2024} / October / 15, year{2025} / January / 15}));
+
+        spec.stub = ShortBack;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / February / 1, year{2024} / May / 1, year{2024} / August / 1,
+                         year{2024} / November / 1, year{2025} / January / 15}));
+
+        spec.stub = LongBack;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / February / 1, year{2024} / May / 1, year{2024} / August / 1,
+                         year{2025} / January / 15}));
+    }
+
+    SECTION("Whole number of periods has no stub") {
+        spec.start = year{2024} / January / 15;
+        for (auto stub : {ShortFront, LongFront, ShortBack, LongBack}) {
+            spec.stub = stub;
+            REQUIRE(unadjustedDates(generator, spec) ==
+                    dayList({year{2024} / January / 15, year{2024} / April / 15,
+                             year{2024} / July / 15, year{2024} / October / 15,
+                             year{2025} / January / 15}));
+        }
+    }
+
+    SECTION("Schedule shorter than a tenor") {
+        spec.start = year{2024} / January / 5;
+        spec.end = year{2024} / January / 20;
+        spec.stub = LongFront;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / January / 5, year{2024} / January / 20}));
+    }
+
+    SECTION("Days of month are clamped without drifting") {
+        spec.start = year{2024} / January / 31;
+        spec.end = year{2024} / May / 31;
+        spec.tenor = months{1};
+        spec.stub = ShortBack;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / January / 31, year{2024} / February / 29,
+                         year{2024} / March / 31, year{2024} / April / 30, year{2024} / May / 31}));
+    }
+
+    SECTION("End of month rolling") {
+        spec.start = year{2024} / February / 29;
+        spec.end = year{2025} / February / 28;
+        spec.stub = ShortBack;
+
+        spec.end_of_month = true;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / February / 29, year{2024} / May / 31,
+                         year{2024} / August / 31, year{2024} / November / 30,
+                         year{2025} / February / 28}));
+
+        spec.end_of_month = false;
+        REQUIRE(unadjustedDates(generator, spec) ==
+                dayList({year{2024} / February / 29, year{2024} / May / 29,
+                         year{2024} / August / 29, year{2024} / November / 29,
+                         year{2025} / February / 28}));
+    }
+}
+
+TEST_CASE("ScheduleGenerator adjusts dates", "[Schedule]") {
+    using enum datelib::BusinessDayConvention;
+    auto calendar = makeUsCalendar();
+    datelib::ScheduleGenerator generator(calendar, 2020, 2030);
+
+    datelib::ScheduleSpec spec;
+    spec.start = year{2024} / March / 30;
+    spec.end = year{2025} / March / 30;
+    spec.tenor = months{3};
+    spec.convention = ModifiedFollowing;
+
+    std::vector<sys_days> unadjusted(datelib::ScheduleGenerator::size(spec));
+    std::vector<sys_days> adjusted(unadjusted.size());
+    REQUIRE(generator.generate(spec, unadjusted, adjusted) == 5);
+
+    // Saturday, March 30th and Sunday, June 30th roll back to stay in their months; Sunday,
+    // March 30th, 2025 rolls forward to Monday the 31st
+    REQUIRE(adjusted == dayList({year{2024} / March / 29, year{2024} / June / 28,
+                                 year{2024} / September / 30, year{2024} / December / 30,
+                                 year{2025} / March / 31}));
+
+    SECTION("Same results as adjust()") {
+        for (auto convention : {Following, ModifiedFollowing, Preceding, ModifiedPreceding,
+                                Unadjusted}) {
+            spec.convention = convention;
+            spec.start = year{2019} / July / 4;
+            spec.end = year{2032} / July / 4;
+            spec.tenor = months{1};
+
+            std::vector<sys_days> dates(datelib::ScheduleGenerator::size(spec));
+            std::vector<sys_days> result(dates.size());
+            REQUIRE(generator.generate(spec, dates, result) == dates.size());
+            for (std::size_t i = 0; i < dates.size(); ++i) {
+                REQUIRE(result[i] == sys_days{datelib::adjust(year_month_day{dates[i]},
+                                                              convention, calendar)});
+            }
+        }
+    }
+}
+
+TEST_CASE("ScheduleGenerator generates portfolios in parallel", "[Schedule]") {
+    using enum datelib::StubRule;
+    using enum datelib::BusinessDayConvention;
+    auto calendar = makeUsCalendar();
+    datelib::ScheduleGenerator generator(calendar, 2020, 2040);
+
+    std::minstd_rand rng(7);
+    std::vector<datelib::ScheduleSpec> specs(2000);
+    for (auto& spec : specs) {
+        auto start = sys_days{year{2020} / January / 1} + std::chrono::days{rng() % 3650};
+        spec.start = year_month_day{start};
+        spec.end = year_month_day{start + std::chrono::days{1 + rng() % 7300}};
+        spec.tenor = months{static_cast<int>(1 + rng() % 12)};
+        spec.stub = std::array{ShortFront, LongFront, ShortBack, LongBack}[rng() % 4];
+        spec.convention = std::array{Following, ModifiedFollowing, Preceding}[rng() % 3];
+        spec.end_of_month = rng() % 2 == 0;
+    }
+
+    auto offsets = datelib::ScheduleGenerator::offsets(specs);
+    REQUIRE(offsets.size() == specs.size() + 1);
+
+    std::vector<sys_days> unadjusted(offsets.back());
+    std::vector<sys_days> adjusted(offsets.back());
+    generator.generate(specs, offsets, unadjusted, adjusted, 4);
+
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+        auto count = offsets[i + 1] - offsets[i];
+        std::vector<sys_days> expected_unadjusted(count);
+        std::vector<sys_days> expected_adjusted(count);
+        REQUIRE(generator.generate(specs[i], expected_unadjusted, expected_adjusted) == count);
+        REQUIRE(std::equal(expected_unadjusted.begin(), expected_unadjusted.end(),
+                           unadjusted.begin() + static_cast<std::ptrdiff_t>(offsets[i])));
+        REQUIRE(std::equal(expected_adjusted.begin(), expected_adjusted.end(),
+                           adjusted.begin() + static_cast<std::ptrdiff_t>(offsets[i])));
+    }
+
+    SECTION("Single-threaded run gives the same dates") {
+        std::vector<sys_days> serial_unadjusted(offsets.back());
+        std::vector<sys_days> serial_adjusted(offsets.back());
+        generator.generate(specs, offsets, serial_unadjusted, serial_adjusted, 1);
+        REQUIRE(serial_unadjusted == unadjusted);
+        REQUIRE(serial_adjusted == adjusted);
+    }
+
+    SECTION("A failing schedule is reported after every thread stops") {
+        specs[1500].end = specs[1500].start;
+        REQUIRE_THROWS_WITH(generator.generate(specs, offsets, unadjusted, adjusted, 4),
+                            "Schedule end date must be after its start date");
+    }
+
+    SECTION("Offsets must match the schedules") {
+        std::vector<std::size_t> short_offsets(offsets.begin(), offsets.end() - 1);
+        REQUIRE_THROWS_AS(generator.generate(specs, short_offsets, unadjusted, adjusted),
+                          std::invalid_argument);
+
+        auto shifted = offsets;
+        shifted[1] += 1;
+        REQUIRE_THROWS_WITH(generator.generate(specs, shifted, unadjusted, adjusted, 4),
+                            "Offsets do not match the schedule sizes");
+
+        std::vector<sys_days> small(offsets.back() - 1);
+        REQUIRE_THROWS_WITH(generator.generate(specs, offsets, small, adjusted),
+                            "Output buffers are too small for the schedules");
+    }
+}
+
+TEST_CASE("ScheduleGenerator validation", "[Schedule]") {
+    datelib::ScheduleGenerator generator(makeUsCalendar(), 2024, 2024);
+    REQUIRE(generator.firstYear() == 2024);
+    REQUIRE(generator.lastYear() == 2024);
+    REQUIRE_THROWS_AS(datelib::ScheduleGenerator(makeUsCalendar(), 2025, 2024),
+                      std::invalid_argument);
+
+    datelib::ScheduleSpec spec;
+    spec.start = year{2024} / January / 1;
+    spec.end = year{2026} / January / 1;
+
+    SECTION("Invalid terms") {
+        auto invalid = spec;
+        invalid.start = year{2024} / February / 30;
+        REQUIRE_THROWS_WITH(datelib::ScheduleGenerator::size(invalid),
+                            "Invalid date provided to schedule");
+
+        invalid = spec;
+        invalid.tenor = months{0};
+        REQUIRE_THROWS_WITH(datelib::ScheduleGenerator::size(invalid),
+                            "Schedule tenor must be positive");
+    }
+
+    SECTION("Buffers too small") {
+        std::vector<sys_days> unadjusted(datelib::ScheduleGenerator::size(spec) - 1);
+        std::vector<sys_days> adjusted(unadjusted.size() + 1);
+        REQUIRE_THROWS_WITH(generator.generate(spec, unadjusted, adjusted),
+                            "Output buffers are too small for the schedule");
+    }
+
+    SECTION("Dates outside the horizon are adjusted through the calendar") {
+        std::vector<sys_days> unadjusted(datelib::ScheduleGenerator::size(spec));
+        std::vector<sys_days> adjusted(unadjusted.size());
+        generator.generate(spec, unadjusted, adjusted);
+        // New Year's Day 2026 is a Thursday, outside the horizon
+        REQUIRE(adjusted.back() == sys_days{year{2026} / January / 2});
+    }
+}
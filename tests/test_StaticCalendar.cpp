@@ -0,0 +1,110 @@
+#include "datelib/HolidayCalendar.h"
+#include "datelib/StaticCalendar.h"
+#include "datelib/date.h"
+
+#include <stdexcept>
+
+#include "catch2/catch.hpp"
+#include "test_fixtures.h"
+
+using namespace std::chrono;
+
+namespace {
+constexpr datelib::StaticCalendar<2020, 2030> US_CALENDAR{
+    datelib::FixedDate{1, 1}, datelib::FixedDate{7, 4}, datelib::FixedDate{12, 25},
+    datelib::NthWeekday{11, 4, datelib::Occurrence::Fourth},
+    datelib::ExplicitDate{year_month_day{year{2025}, month{1}, day{9}}}};
+} // namespace
+
+TEST_CASE("Rule dates are usable in constant expressions", "[StaticCalendar]") {
+    using datelib::Occurrence;
+
+    STATIC_REQUIRE(datelib::FixedDate{12, 25}.tryCalculate(2024) ==
+                   year_month_day{year{2024}, month{12}, day{25}});
+    STATIC_REQUIRE_FALSE(datelib::FixedDate{2, 29}.tryCalculate(2023).has_value());
+    STATIC_REQUIRE(datelib::NthWeekday{11, 4, Occurrence::Fourth}.tryCalculate(2024) ==
+                   year_month_day{year{2024}, month{11}, day{28}});
+    STATIC_REQUIRE(datelib::NthWeekday{5, 1, Occurrence::Last}.tryCalculate(2024) ==
+                   year_month_day{year{2024}, month{5}, day{27}});
+    STATIC_REQUIRE_FALSE(datelib::NthWeekday{2, 1, Occurrence::Fifth}.tryCalculate(2023));
+    STATIC_REQUIRE_FALSE(
+        datelib::ExplicitDate{year_month_day{year{2024}, month{4}, day{8}}}.tryCalculate(2025));
+    STATIC_REQUIRE(datelib::EasterOffset{-2}.tryCalculate(2024) ==
+                   year_month_day{year{2024}, month{3}, day{29}});
+    STATIC_REQUIRE(datelib::EasterOffset{1, datelib::EasterType::Orthodox}.tryCalculate(2024) ==
+                   year_month_day{year{2024}, month{5}, day{6}});
+
+    REQUIRE_THROWS_AS(datelib::FixedDate(13, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::FixedDate(1, 32), std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::NthWeekday(1, 7, Occurrence::First), std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::NthWeekday(1, 1, static_cast<Occurrence>(0)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::ExplicitDate(year_month_day{year{2023}, month{2}, day{29}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::EasterOffset(400), std::invalid_argument);
+}
+
+TEST_CASE("StaticCalendar evaluated at compile time", "[StaticCalendar]") {
+    using enum datelib::BusinessDayConvention;
+
+    STATIC_REQUIRE(US_CALENDAR.firstYear() == 2020);
+    STATIC_REQUIRE(US_CALENDAR.lastYear() == 2030);
+    STATIC_REQUIRE(US_CALENDAR.contains(year_month_day{year{2030}, month{12}, day{31}}));
+    STATIC_REQUIRE_FALSE(US_CALENDAR.contains(year_month_day{year{2031}, month{1}, day{1}}));
+
+    STATIC_REQUIRE(US_CALENDAR.isHoliday(year_month_day{year{2024}, month{11}, day{28}}));
+    STATIC_REQUIRE(US_CALENDAR.isHoliday(year_month_day{year{2025}, month{1}, day{9}}));
+    STATIC_REQUIRE_FALSE(US_CALENDAR.isHoliday(year_month_day{year{2026}, month{1}, day{9}}));
+    STATIC_REQUIRE_FALSE(US_CALENDAR.isHoliday(year_month_day{year{2024}, month{2}, day{30}}));
+    STATIC_REQUIRE(US_CALENDAR.getHolidayBitmap(2025).count() == 5);
+
+    STATIC_REQUIRE_FALSE(
+        datelib::isBusinessDay(year_month_day{year{2024}, month{12}, day{25}}, US_CALENDAR));
+    // Christmas 2022 falls on a Sunday and is not observed on the Monday
+    STATIC_REQUIRE(datelib::isBusinessDay(year_month_day{year{2022}, month{12}, day{26}},
+                                          US_CALENDAR, datelib::SUNDAY_WEEKEND));
+    STATIC_REQUIRE(datelib::adjust(year_month_day{year{2022}, month{12}, day{24}}, Following,
+                                   US_CALENDAR) == year_month_day{year{2022}, month{12}, day{26}});
+    STATIC_REQUIRE(datelib::adjust(year_month_day{year{2024}, month{12}, day{25}}, Preceding,
+                                   US_CALENDAR) == year_month_day{year{2024}, month{12}, day{24}});
+}
+
+TEST_CASE("StaticCalendar matches HolidayCalendar", "[StaticCalendar]") {
+    using enum datelib::BusinessDayConvention;
+    auto calendar = makeUsCalendar();
+
+    for (int y = 2020; y <= 2030; ++y) {
+        REQUIRE(US_CALENDAR.getHolidayBitmap(y) == calendar.getHolidayBitmap(y));
+        REQUIRE(US_CALENDAR.getBusinessDayBitmap(y, datelib::FRIDAY_SATURDAY_WEEKEND) ==
+                calendar.getBusinessDayBitmap(y, datelib::FRIDAY_SATURDAY_WEEKEND));
+    }
+
+    auto start = sys_days{year{2021} / January / 1};
+    for (auto d = start; d < sys_days{year{2030} / January / 1}; d += days{1}) {
+        year_month_day date{d};
+        REQUIRE(datelib::isBusinessDay(date, US_CALENDAR) ==
+                datelib::isBusinessDay(date, calendar));
+        for (auto convention : {Following, ModifiedFollowing, Preceding, ModifiedPreceding}) {
+            REQUIRE(datelib::adjust(date, convention, US_CALENDAR) ==
+                    datelib::adjust(date, convention, calendar));
+        }
+    }
+}
+
+TEST_CASE("StaticCalendar errors", "[StaticCalendar]") {
+    using enum datelib::BusinessDayConvention;
+
+    REQUIRE_THROWS_AS(US_CALENDAR.isHoliday(year_month_day{year{2031}, month{1}, day{1}}),
+                      datelib::YearOutOfRangeException);
+    REQUIRE_THROWS_AS(US_CALENDAR.getHolidayBitmap(2019), std::out_of_range);
+    // New Year's Day 2020 is a holiday; the previous business day lies in 2019
+    REQUIRE_THROWS_AS(
+        datelib::adjust(year_month_day{year{2020}, month{1}, day{1}}, Preceding, US_CALENDAR),
+        datelib::YearOutOfRangeException);
+    REQUIRE_THROWS_AS(
+        datelib::isBusinessDay(year_month_day{year{2024}, month{2}, day{30}}, US_CALENDAR),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(datelib::adjust(year_month_day{year{2024}, month{2}, day{30}}, Following,
+                                      US_CALENDAR),
+                      std::invalid_argument);
+}
@@ -0,0 +1,45 @@
+#include "datelib/detail/civil.h"
+
+#include "catch2/catch.hpp"
+
+using namespace std::chrono;
+
+namespace civil = datelib::detail;
+
+TEST_CASE("Civil conversions in constant expressions", "[civil]") {
+    STATIC_REQUIRE(civil::daysFromCivil(1970, 1, 1) == 0);
+    STATIC_REQUIRE(civil::daysFromCivil(2000, 3, 1) == 11017);
+    STATIC_REQUIRE(civil::daysFromCivil(1969, 12, 31) == -1);
+    STATIC_REQUIRE(civil::civilFromDays(11016).year == 2000);
+    STATIC_REQUIRE(civil::civilFromDays(11016).month == 2);
+    STATIC_REQUIRE(civil::civilFromDays(11016).day == 29);
+    STATIC_REQUIRE(civil::weekdayFromDays(0) == 4);
+    STATIC_REQUIRE(civil::weekdayFromDays(-1) == 3);
+    STATIC_REQUIRE(civil::toYearMonthDay(sys_days{days{19723}}) == 2024y / January / 1);
+}
+
+TEST_CASE("Civil conversions match std::chrono over the whole year range", "[civil]") {
+    // Every day from -32767-01-01 to 32767-12-31
+    const sys_days first{year::min() / January / 1};
+    const sys_days last{year::max() / December / 31};
+
+    std::size_t mismatches = 0;
+    for (auto day = first; day <= last; day += days{1}) {
+        year_month_day expected{day};
+        auto count = static_cast<std::int32_t>(day.time_since_epoch().count());
+
+        auto civil_date = civil::civilFromDays(count);
+        auto round_trip = civil::daysFromCivil(static_cast<int>(expected.year()),
+                                               static_cast<unsigned>(expected.month()),
+                                               static_cast<unsigned>(expected.day()));
+        if (civil_date.year != static_cast<int>(expected.year()) ||
+            civil_date.month != static_cast<unsigned>(expected.month()) ||
+            civil_date.day != static_cast<unsigned>(expected.day()) || round_trip != count ||
+            civil::weekdayOf(day) != weekday{day}) {
+            ++mismatches;
+        }
+    }
+
+    // A single assertion keeps the 24 million checks fast
+    REQUIRE(mismatches == 0);
+}
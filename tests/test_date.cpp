@@ -2,6 +2,9 @@
 #include "datelib/HolidayCalendar.h"
 #include "datelib/date.h"
 
+#include <limits>
+#include <vector>
+
 #include "catch2/catch.hpp"
 
 using namespace std::chrono;
@@ -295,6 +298,128 @@ TEST_CASE("isBusinessDay with custom weekend days", "[isBusinessDay][configurabl
     }
 }
 
+TEST_CASE("WeekendMask", "[WeekendMask]") {
+    SECTION("Predefined masks") {
+        STATIC_REQUIRE(datelib::SATURDAY_SUNDAY_WEEKEND.contains(Saturday));
+        STATIC_REQUIRE(datelib::SATURDAY_SUNDAY_WEEKEND.contains(Sunday));
+        STATIC_REQUIRE_FALSE(datelib::SATURDAY_SUNDAY_WEEKEND.contains(Friday));
+        STATIC_REQUIRE(datelib::FRIDAY_SATURDAY_WEEKEND.contains(Friday));
+        STATIC_REQUIRE_FALSE(datelib::FRIDAY_SATURDAY_WEEKEND.contains(Sunday));
+        STATIC_REQUIRE(datelib::SUNDAY_WEEKEND.bits() == 0x01);
+        STATIC_REQUIRE(datelib::WeekendMask{}.empty());
+    }
+
+    SECTION("Conversion from a set of weekdays") {
+        std::unordered_set<weekday, datelib::WeekdayHash> friday_saturday = {Friday, Saturday};
+        REQUIRE(datelib::WeekendMask{friday_saturday} == datelib::FRIDAY_SATURDAY_WEEKEND);
+        REQUIRE(datelib::WeekendMask{std::unordered_set<weekday, datelib::WeekdayHash>{}}.empty());
+    }
+
+    SECTION("Raw bits are limited to seven weekdays") {
+        REQUIRE(datelib::WeekendMask::fromBits(0xFF).bits() == datelib::WeekendMask::ALL_DAYS);
+        REQUIRE(datelib::WeekendMask{}.with(weekday{9}).empty());
+        REQUIRE_FALSE(datelib::WeekendMask::fromBits(0xFF).contains(weekday{9}));
+    }
+
+    SECTION("Weekend days of a year") {
+        // 2024 starts on a Monday and has 52 Saturdays and 52 Sundays
+        auto weekends = datelib::SATURDAY_SUNDAY_WEEKEND.daysIn(2024);
+        REQUIRE(weekends.count() == 104);
+        REQUIRE(weekends.test(datelib::YearBitmap::indexOf(2024y / January / 6d)));
+        REQUIRE_FALSE(weekends.test(datelib::YearBitmap::indexOf(2024y / January / 5d)));
+        // 2023 starts and ends on a Sunday
+        REQUIRE(datelib::SUNDAY_WEEKEND.daysIn(2023).count() == 53);
+        REQUIRE(datelib::WeekendMask{}.daysIn(2023).none());
+    }
+
+    SECTION("Mask overloads agree with set overloads") {
+        datelib::HolidayCalendar calendar;
+        calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+        std::unordered_set<weekday, datelib::WeekdayHash> friday_saturday = {Friday, Saturday};
+
+        auto start = sys_days{year{2024} / December / 1};
+        for (auto d = start; d < start + days{45}; d += days{1}) {
+            year_month_day ymd{d};
+            REQUIRE(datelib::isBusinessDay(ymd, calendar, datelib::FRIDAY_SATURDAY_WEEKEND) ==
+                    datelib::isBusinessDay(ymd, calendar, friday_saturday));
+            REQUIRE(datelib::adjust(ymd, datelib::BusinessDayConvention::ModifiedFollowing,
+                                    calendar, datelib::FRIDAY_SATURDAY_WEEKEND) ==
+                    datelib::adjust(ymd, datelib::BusinessDayConvention::ModifiedFollowing,
+                                    calendar, friday_saturday));
+        }
+    }
+
+    SECTION("Sunday-only weekend") {
+        datelib::HolidayCalendar calendar;
+        // Saturday, January 6, 2024 -> unchanged with a Sunday-only weekend
+        auto saturday = year_month_day{year{2024}, month{1}, day{6}};
+        REQUIRE(datelib::isBusinessDay(saturday, calendar, datelib::SUNDAY_WEEKEND));
+        // Sunday, January 7, 2024 -> Monday, January 8, 2024
+        REQUIRE(datelib::adjust(year_month_day{year{2024}, month{1}, day{7}},
+                                datelib::BusinessDayConvention::Following, calendar,
+                                datelib::SUNDAY_WEEKEND) ==
+                year_month_day{year{2024}, month{1}, day{8}});
+    }
+}
+
+TEST_CASE("isBusinessDay over spans of days", "[isBusinessDay][batch]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    calendar.addRule(std::make_unique<datelib::NthWeekdayRule>("Thanksgiving", 11, 4,
+                                                               datelib::Occurrence::Fourth));
+
+    auto check = [&](const std::vector<sys_days>& days_column, datelib::WeekendMask weekend) {
+        std::vector<std::uint8_t> results(days_column.size(), 0xFF);
+        datelib::isBusinessDay(days_column, results, calendar, weekend);
+        for (std::size_t i = 0; i < days_column.size(); ++i) {
+            REQUIRE(results[i] ==
+                    (datelib::isBusinessDay(year_month_day{days_column[i]}, calendar, weekend)
+                         ? 1
+                         : 0));
+        }
+    };
+
+    SECTION("Consecutive days across several years") {
+        std::vector<sys_days> days_column;
+        auto start = sys_days{year{1968} / December / 3};
+        for (int offset = 0; offset < 3 * 366 + 5; ++offset) {
+            days_column.push_back(start + days{offset});
+        }
+        check(days_column, datelib::SATURDAY_SUNDAY_WEEKEND);
+        check(days_column, datelib::FRIDAY_SATURDAY_WEEKEND);
+    }
+
+    SECTION("Scattered days in no particular order") {
+        std::vector<sys_days> days_column;
+        auto start = sys_days{year{2000} / January / 1};
+        for (int i = 0; i < 1001; ++i) {
+            days_column.push_back(start + days{(i * 7919) % 18000});
+        }
+        check(days_column, datelib::SUNDAY_WEEKEND);
+    }
+
+    SECTION("Days spanning more than a thousand years") {
+        std::vector<sys_days> days_column = {sys_days{year{900} / December / 25},
+                                             sys_days{year{2024} / November / 28},
+                                             sys_days{year{2024} / November / 29}};
+        check(days_column, datelib::SATURDAY_SUNDAY_WEEKEND);
+    }
+
+    SECTION("Empty column") {
+        std::vector<sys_days> empty;
+        std::vector<std::uint8_t> results;
+        REQUIRE_NOTHROW(datelib::isBusinessDay(empty, results, calendar));
+    }
+
+    SECTION("Mismatched sizes") {
+        std::vector<sys_days> days_column(3, sys_days{year{2024} / January / 1});
+        std::vector<std::uint8_t> results(2);
+        REQUIRE_THROWS_AS(datelib::isBusinessDay(days_column, results, calendar),
+                          std::invalid_argument);
+    }
+}
+
 TEST_CASE("adjust with Following convention", "[adjust]") {
     datelib::HolidayCalendar calendar;
 
@@ -517,6 +642,191 @@ TEST_CASE("adjust with custom weekend days", "[adjust][configurable]") {
     }
 }
 
+namespace {
+// Reference implementation of addBusinessDays that steps one day at a time
+year_month_day stepBusinessDays(year_month_day date, int n,
+                                const datelib::HolidayCalendar& calendar,
+                                datelib::WeekendMask weekend) {
+    auto current = sys_days{date};
+    int step = n >= 0 ? 1 : -1;
+    for (int remaining = n >= 0 ? n : -n; remaining > 0;) {
+        current += days{step};
+        if (datelib::isBusinessDay(year_month_day{current}, calendar, weekend)) {
+            --remaining;
+        }
+    }
+    return year_month_day{current};
+}
+} // namespace
+
+TEST_CASE("addBusinessDays", "[addBusinessDays]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Boxing Day", 12, 26));
+
+    SECTION("T+2 settlement") {
+        // Thursday, January 4, 2024 + 2 -> Monday, January 8, 2024
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{4}}, 2,
+                                         calendar) == year_month_day{year{2024}, month{1}, day{8}});
+    }
+
+    SECTION("Crossing holidays and a year boundary") {
+        // Monday, December 23, 2024 + 5 skips Christmas, Boxing Day, the weekend and New Year's
+        // Day -> Thursday, January 2, 2025
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2024}, month{12}, day{23}}, 5,
+                                         calendar) == year_month_day{year{2025}, month{1}, day{2}});
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2025}, month{1}, day{2}}, -5,
+                                         calendar) ==
+                year_month_day{year{2024}, month{12}, day{23}});
+    }
+
+    SECTION("Zero offset rolls forward only from non-business days") {
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{4}}, 0,
+                                         calendar) == year_month_day{year{2024}, month{1}, day{4}});
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{6}}, 0,
+                                         calendar) == year_month_day{year{2024}, month{1}, day{8}});
+    }
+
+    SECTION("Starting from a non-business day") {
+        // Saturday, January 6, 2024: the next business day is Monday, January 8, 2024
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{6}}, 1,
+                                         calendar) == year_month_day{year{2024}, month{1}, day{8}});
+        REQUIRE(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{6}}, -1,
+                                         calendar) == year_month_day{year{2024}, month{1}, day{5}});
+    }
+
+    SECTION("Matches stepping one day at a time") {
+        auto start = sys_days{year{2023} / November / 20};
+        for (int offset = 0; offset < 60; offset += 3) {
+            for (int n : {1, 2, 5, 22, 251, 600, -1, -2, -5, -22, -251, -600}) {
+                year_month_day date{start + days{offset}};
+                REQUIRE(datelib::addBusinessDays(date, n, calendar,
+                                                 datelib::FRIDAY_SATURDAY_WEEKEND) ==
+                        stepBusinessDays(date, n, calendar, datelib::FRIDAY_SATURDAY_WEEKEND));
+            }
+        }
+    }
+
+    SECTION("Invalid date") {
+        REQUIRE_THROWS_WITH(
+            datelib::addBusinessDays(year_month_day{year{2024}, month{2}, day{30}}, 1, calendar),
+            "Invalid date provided to addBusinessDays");
+    }
+
+    SECTION("Targets outside the range of years") {
+        // Friday, December 29, 32767 and Monday, January 3, -32767 are the last and first
+        // business days that std::chrono::year can represent
+        const year_month_day last{year::max(), December, day{29}};
+        const year_month_day first{year::min(), January, day{3}};
+        REQUIRE(datelib::addBusinessDays(year_month_day{year::max(), December, day{27}}, 2,
+                                         calendar) == last);
+        REQUIRE_THROWS_AS(datelib::addBusinessDays(last, 1, calendar),
+                          datelib::BusinessDaySearchException);
+        REQUIRE(datelib::addBusinessDays(year_month_day{year::min(), January, day{5}}, -2,
+                                         calendar) == first);
+        REQUIRE_THROWS_AS(datelib::addBusinessDays(first, -1, calendar),
+                          datelib::BusinessDaySearchException);
+
+        // Far beyond the range, whether or not the distance alone rules the target out
+        const year_month_day start{year{2024}, month{1}, day{2}};
+        for (int n : {10'000'000, -10'000'000, std::numeric_limits<int>::max(),
+                      std::numeric_limits<int>::min()}) {
+            REQUIRE_THROWS_AS(datelib::addBusinessDays(start, n, calendar),
+                              datelib::BusinessDaySearchException);
+        }
+    }
+
+    SECTION("Calendar without business days") {
+        auto all_days = datelib::WeekendMask::fromBits(datelib::WeekendMask::ALL_DAYS);
+        REQUIRE_THROWS_AS(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{4}}, 1,
+                                                   calendar, all_days),
+                          datelib::BusinessDaySearchException);
+        REQUIRE_THROWS_AS(datelib::addBusinessDays(year_month_day{year{2024}, month{1}, day{4}},
+                                                   -1, calendar, all_days),
+                          datelib::BusinessDaySearchException);
+    }
+}
+
+TEST_CASE("adjust over spans of dates", "[adjust][batch]") {
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    calendar.addRule(
+        std::make_unique<datelib::NthWeekdayRule>("Memorial Day", 5, 1, datelib::Occurrence::Last));
+    calendar.addHoliday("Special Closing", year_month_day{year{2024}, month{5}, day{31}});
+
+    // Sorted column with repeated dates, spanning a year boundary
+    std::vector<year_month_day> sorted;
+    auto start = sys_days{year{2023} / December / 20};
+    for (int offset = 0; offset < 200; ++offset) {
+        sorted.emplace_back(start + days{offset});
+        if (offset % 5 == 0) {
+            sorted.emplace_back(start + days{offset});
+        }
+    }
+
+    // Same dates in a scrambled order
+    std::vector<year_month_day> unsorted = sorted;
+    for (std::size_t i = 0; i < unsorted.size(); i += 2) {
+        std::swap(unsorted[i], unsorted[unsorted.size() - 1 - i / 3]);
+    }
+
+    using enum datelib::BusinessDayConvention;
+    for (auto convention :
+         {Following, ModifiedFollowing, Preceding, ModifiedPreceding, Unadjusted}) {
+        for (const auto* column : {&sorted, &unsorted}) {
+            std::vector<year_month_day> adjusted(column->size());
+            datelib::adjust(*column, adjusted, convention, calendar,
+                            datelib::FRIDAY_SATURDAY_WEEKEND);
+            for (std::size_t i = 0; i < column->size(); ++i) {
+                REQUIRE(adjusted[i] == datelib::adjust((*column)[i], convention, calendar,
+                                                       datelib::FRIDAY_SATURDAY_WEEKEND));
+            }
+        }
+    }
+
+    SECTION("sys_days column") {
+        std::vector<sys_days> days_column;
+        for (const auto& date : sorted) {
+            days_column.emplace_back(date);
+        }
+        std::vector<sys_days> adjusted(days_column.size());
+        datelib::adjust(days_column, adjusted, ModifiedFollowing, calendar);
+        for (std::size_t i = 0; i < days_column.size(); ++i) {
+            REQUIRE(year_month_day{adjusted[i]} ==
+                    datelib::adjust(sorted[i], ModifiedFollowing, calendar));
+        }
+    }
+
+    SECTION("In-place adjustment") {
+        std::vector<year_month_day> column = sorted;
+        datelib::adjust(column, column, Preceding, calendar);
+        for (std::size_t i = 0; i < column.size(); ++i) {
+            REQUIRE(column[i] == datelib::adjust(sorted[i], Preceding, calendar));
+        }
+    }
+
+    SECTION("Empty column") {
+        std::vector<year_month_day> empty;
+        REQUIRE_NOTHROW(datelib::adjust(empty, empty, Following, calendar));
+    }
+
+    SECTION("Mismatched sizes") {
+        std::vector<year_month_day> adjusted(sorted.size() - 1);
+        REQUIRE_THROWS_WITH(datelib::adjust(sorted, adjusted, Following, calendar),
+                            "Input and output spans must have the same size");
+    }
+
+    SECTION("Invalid date in the column") {
+        std::vector<year_month_day> column = {year_month_day{year{2024}, month{1}, day{6}},
+                                              year_month_day{year{2024}, month{2}, day{30}}};
+        std::vector<year_month_day> adjusted(column.size());
+        REQUIRE_THROWS_WITH(datelib::adjust(column, adjusted, Following, calendar),
+                            "Invalid date provided to adjust");
+    }
+}
+
 TEST_CASE("adjust with invalid enum value", "[adjust][edge_cases]") {
     datelib::HolidayCalendar calendar;
     // Use a weekend (Saturday) to ensure it's not a business day
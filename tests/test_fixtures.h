@@ -0,0 +1,38 @@
+#pragma once
+
+#include "datelib/HolidayCalendar.h"
+
+#include <chrono>
+#include <memory>
+
+/**
+ * @brief Calendars shared by several test files
+ */
+
+/**
+ * @brief A US-style calendar: four rules and one explicit closing on 2025-01-09
+ */
+inline datelib::HolidayCalendar makeUsCalendar() {
+    using namespace std::chrono;
+
+    datelib::HolidayCalendar calendar;
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("New Year's Day", 1, 1));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Independence Day", 7, 4));
+    calendar.addRule(std::make_unique<datelib::FixedDateRule>("Christmas", 12, 25));
+    calendar.addRule(std::make_unique<datelib::NthWeekdayRule>("Thanksgiving", 11, 4,
+                                                               datelib::Occurrence::Fourth));
+    calendar.addHoliday("Special Closing", year_month_day{year{2025}, month{1}, day{9}});
+    return calendar;
+}
+
+/**
+ * @brief makeUsCalendar() with an explicit holiday on Christmas 2024, so that one date has two
+ * names
+ */
+inline datelib::HolidayCalendar makeUsCalendarWithSharedDate() {
+    using namespace std::chrono;
+
+    auto calendar = makeUsCalendar();
+    calendar.addHoliday("Founders Day", year_month_day{year{2024}, month{12}, day{25}});
+    return calendar;
+}